@@ -0,0 +1,570 @@
+// Benchmark suite for the module ABI, run in-process against the reference
+// host (host/HostCore). Every call goes through ModuleAPI and the gateway
+// function pointers, exactly as a loaded module would make it.
+// Prints one CSV row per measurement: benchmark,variant,threads,param,ns_per_op
+// The `allocations` rows report heap allocations per call instead of ns;
+// the run fails if a steady-state updateParallel, reduceParallel or task submit
+// allocates (checked on one thread and on several), or if
+// reduceParallel gives different results for different thread counts, or
+// if the spatial index misses or invents neighbours.
+//
+// Usage: FractalBench [entities] [maxThreads]
+
+#include "HostCore.h"
+#include "headers/FractalCORE_wrapper.h"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <new>
+#include <string>
+#include <vector>
+
+// Counts every global allocation made by the module API and the host. All
+// forms of operator new and delete are replaced so none bypasses the count.
+static std::atomic<size_t> g_allocations{ 0 };
+
+namespace {
+
+// Kept out of line so GCC never pairs the free() in release() with an
+// operator new it sees at an inlined call site (-Wmismatched-new-delete).
+[[gnu::noinline]] void* countedAlloc(size_t size, size_t align = 0) noexcept {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (size == 0) size = 1;
+    if (align <= alignof(std::max_align_t)) return std::malloc(size);
+    return std::aligned_alloc(align, (size + align - 1) & ~(align - 1));
+}
+
+[[gnu::noinline]] void release(void* p) noexcept { std::free(p); }
+
+void* countedAllocOrThrow(size_t size, size_t align = 0) {
+    if (void* p = countedAlloc(size, align)) return p;
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+void* operator new(size_t size) { return countedAllocOrThrow(size); }
+void* operator new[](size_t size) { return countedAllocOrThrow(size); }
+void* operator new(size_t size, std::align_val_t align) { return countedAllocOrThrow(size, size_t(align)); }
+void* operator new[](size_t size, std::align_val_t align) { return countedAllocOrThrow(size, size_t(align)); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new(size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return countedAlloc(size, size_t(align));
+}
+void* operator new[](size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return countedAlloc(size, size_t(align));
+}
+
+void operator delete(void* p) noexcept { release(p); }
+void operator delete[](void* p) noexcept { release(p); }
+void operator delete(void* p, size_t) noexcept { release(p); }
+void operator delete[](void* p, size_t) noexcept { release(p); }
+void operator delete(void* p, std::align_val_t) noexcept { release(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { release(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { release(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { release(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { release(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { release(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { release(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { release(p); }
+
+struct VelocityComponent {
+    float dx = 0.0f;
+    float dy = 0.0f;
+};
+FRACTAL_SOA_LAYOUT(VelocityComponent, &VelocityComponent::dx, &VelocityComponent::dy);
+
+namespace {
+
+struct PositionComponent {
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+struct PingEvent {
+    uint32_t value;
+};
+
+using BenchClock = std::chrono::steady_clock;
+
+template<typename F>
+double nsPerOp(size_t ops, int repeats, F&& body) {
+    body(); // warm-up
+    const auto start = BenchClock::now();
+    for (int i = 0; i < repeats; ++i) body();
+    const double ns = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+    return ns / (static_cast<double>(ops) * repeats);
+}
+
+void row(const char* benchmark, const char* variant, size_t threads, const std::string& param, double ns) {
+    std::printf("%s,%s,%zu,%s,%.4f\n", benchmark, variant, threads, param.c_str(), ns);
+}
+
+void moveEntity(Entity, PositionComponent& p) {
+    p.x += 1.0f;
+    p.y += 0.5f;
+}
+
+void dampVelocities(SoAChunk<VelocityComponent> chunk, void*) {
+    for (float& dx : chunk.column<&VelocityComponent::dx>()) dx *= 0.5f;
+    for (float& dy : chunk.column<&VelocityComponent::dy>()) dy *= 0.5f;
+}
+
+void benchCreation(size_t entities) {
+    // Each sample needs a fresh core, so time one round per core.
+    auto sample = [&](bool bulk) {
+        HostCore core(1);
+        ModuleAPI api(core.gateway());
+        auto handle = api.registerComponent<PositionComponent>("Position", entities);
+        std::vector<PositionComponent> positions(entities);
+        const auto start = BenchClock::now();
+        if (bulk) {
+            api.attachComponents<PositionComponent>(api.createEntities(entities), handle, positions);
+        } else {
+            for (size_t i = 0; i < entities; ++i) api.attachComponent(api.createEntity(), handle, positions[i]);
+        }
+        return std::chrono::duration<double, std::nano>(BenchClock::now() - start).count() / entities;
+    };
+    row("create", "loop", 1, std::to_string(entities), sample(false));
+    row("create", "bulk", 1, std::to_string(entities), sample(true));
+}
+
+// Warm start vs cold start: restoring a snapshot against rebuilding the
+// same entities with bulk creation (see the create rows).
+void benchSnapshot(size_t entities) {
+    const std::string path = (std::filesystem::temp_directory_path() / "fractal_bench.snapshot").string();
+    double saveNs = 0.0;
+    {
+        HostCore core(1);
+        ModuleAPI api(core.gateway());
+        auto handle = api.registerComponent<PositionComponent>("Position", entities);
+        std::vector<PositionComponent> positions(entities);
+        api.attachComponents<PositionComponent>(api.createEntities(entities), handle, positions);
+        const auto start = BenchClock::now();
+        if (!api.saveSnapshot(path)) return;
+        saveNs = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+    }
+    HostCore core(1);
+    ModuleAPI api(core.gateway());
+    api.registerComponent<PositionComponent>("Position", entities);
+    const auto start = BenchClock::now();
+    const bool loaded = api.loadSnapshot(path);
+    const double loadNs = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+    std::filesystem::remove(path);
+    if (!loaded) return;
+    row("snapshot", "save", 1, std::to_string(entities), saveNs / entities);
+    row("snapshot", "load", 1, std::to_string(entities), loadNs / entities);
+}
+
+// Spawn/despawn cycles as in projectile-heavy scenes: IDs are recycled, so
+// the sparse table stays the size of the live set after compaction. Bulk
+// spawns reuse runs of free slots too; the run fails if they grow the slot
+// table instead.
+bool benchChurn(size_t entities) {
+    HostCore core(1);
+    ModuleAPI api(core.gateway());
+    auto handle = api.registerComponent<PositionComponent>("Position", entities);
+    std::vector<Entity> live(entities);
+
+    row("churn", "create+attach+destroy", 1, std::to_string(entities), nsPerOp(entities, 5, [&] {
+        for (Entity& e : live) {
+            e = api.createEntity();
+            api.attachComponent(e, handle, PositionComponent{});
+        }
+        api.destroyEntities(std::span<const Entity>(live));
+    }));
+    api.compactStorage();
+    row("churn", "sparse_pages_after_compact", 1, std::to_string(entities),
+        static_cast<double>(core.sparsePageCount()));
+
+    // Spawn waves of an eighth of the set each, then despawn everything.
+    const size_t wave = std::max<size_t>(entities / 8, 1);
+    std::vector<PositionComponent> positions(wave);
+    std::vector<EntityRange> waves;
+    const size_t slotsBefore = core.slotCount();
+    row("churn", "bulk_create+attach+destroy", 1, std::to_string(entities), nsPerOp(entities, 5, [&] {
+        waves.clear();
+        for (size_t spawned = 0; spawned + wave <= entities; spawned += wave) {
+            waves.push_back(api.createEntities(wave));
+            api.attachComponents<PositionComponent>(waves.back(), handle, positions);
+        }
+        for (const EntityRange& range : waves) api.destroyEntities(range);
+    }));
+    row("churn", "bulk_slots", 1, std::to_string(entities), static_cast<double>(core.slotCount()));
+    if (core.slotCount() > slotsBefore) {
+        std::fprintf(stderr, "FractalBench: bulk churn grew the slot table from %zu to %zu\n", slotsBefore,
+                     core.slotCount());
+        return false;
+    }
+    return true;
+}
+
+void benchUpdate(size_t entities, size_t threads) {
+    HostCore core(threads);
+    ModuleAPI api(core.gateway());
+    auto handle = api.registerComponent<PositionComponent>("Position", entities);
+    std::vector<PositionComponent> positions(entities);
+    api.attachComponents<PositionComponent>(api.createEntities(entities), handle, positions);
+
+    for (size_t chunk : { size_t(64), size_t(256), size_t(1024), size_t(4096) }) {
+        row("updateParallel", "fixed", threads, std::to_string(chunk),
+            nsPerOp(entities, 20, [&] { api.updateParallel(handle, moveEntity, chunk); }));
+    }
+    // Let the tuner settle before timing the auto pass.
+    for (int i = 0; i < 32; ++i) api.updateParallel(handle, moveEntity, AutoChunkSize);
+    row("updateParallel", "auto", threads, "auto",
+        nsPerOp(entities, 20, [&] { api.updateParallel(handle, moveEntity, AutoChunkSize); }));
+}
+
+struct Bounds {
+    float minX = 3.4e38f;
+    float maxX = -3.4e38f;
+    double sumY = 0.0;
+};
+
+void boundsChunk(std::span<const Entity>, std::span<const PositionComponent> positions, Bounds& acc, void*) {
+    for (const PositionComponent& p : positions) {
+        acc.minX = std::min(acc.minX, p.x);
+        acc.maxX = std::max(acc.maxX, p.x);
+        acc.sumY += p.y;
+    }
+}
+
+void mergeBounds(Bounds& into, const Bounds& from) {
+    into.minX = std::min(into.minX, from.minX);
+    into.maxX = std::max(into.maxX, from.maxX);
+    into.sumY += from.sumY;
+}
+
+// Aggregate over all positions. Returns the sum so runs with different
+// thread counts can be compared; they must agree bit for bit.
+double benchReduce(size_t entities, size_t threads) {
+    HostCore core(threads);
+    ModuleAPI api(core.gateway());
+    auto handle = api.registerComponent<PositionComponent>("Position", entities);
+    std::vector<PositionComponent> positions(entities);
+    for (size_t i = 0; i < entities; ++i) positions[i] = { float(i % 977) * 0.37f, float(i % 131) * 0.013f };
+    api.attachComponents<PositionComponent>(api.createEntities(entities), handle, positions);
+
+    Bounds result;
+    row("reduceParallel", "chunks", threads, "1024", nsPerOp(entities, 20, [&] {
+        result = api.reduceParallel(handle, Bounds{}, boundsChunk, mergeBounds, nullptr, 1024);
+    }));
+    return result.sumY;
+}
+
+// Radius queries against the spatial index vs a scan of every position,
+// at a constant density of one entity per 16 square units. Returns false if
+// the two disagree.
+bool benchSpatial(size_t entities, size_t threads) {
+    HostCore core(threads);
+    ModuleAPI api(core.gateway());
+    auto handle = api.registerComponent<PositionComponent>("Position", entities);
+    const float side = std::sqrt(static_cast<float>(entities) * 16.0f);
+    std::vector<PositionComponent> positions(entities);
+    uint32_t seed = 12345;
+    auto next = [&] {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<float>(seed >> 8) / 16777216.0f * side;
+    };
+    for (PositionComponent& p : positions) p = { next(), next() };
+    api.attachComponents<PositionComponent>(api.createEntities(entities), handle, positions);
+
+    SpatialGrid<PositionComponent> grid(16.0f);
+    const std::string n = std::to_string(entities);
+    row("spatial", "rebuild", threads, n, nsPerOp(entities, 5, [&] { api.rebuildSpatialIndex(handle, grid); }));
+
+    constexpr size_t kQueries = 1000;
+    std::vector<RadiusQuery> queries(kQueries);
+    for (RadiusQuery& q : queries) q = { next(), next(), 8.0f };
+    SpatialQueryResults results;
+    row("spatial", "radius", threads, n, nsPerOp(kQueries, 5, [&] { grid.queryRadius(queries, results); }));
+
+    // The scan is O(N) per query; a sample of queries is enough.
+    constexpr size_t kScanned = 20;
+    std::vector<size_t> scanned(kScanned);
+    const std::span<const PositionComponent> all(positions);
+    row("spatial", "scan", threads, n, nsPerOp(kScanned, 1, [&] {
+        for (size_t i = 0; i < kScanned; ++i) {
+            scanned[i] = 0;
+            for (const PositionComponent& p : all) {
+                const float dx = p.x - queries[i].x, dy = p.y - queries[i].y;
+                scanned[i] += dx * dx + dy * dy <= queries[i].radius * queries[i].radius;
+            }
+        }
+    }));
+    for (size_t i = 0; i < kScanned; ++i) {
+        if (results[i].size() != scanned[i]) return false;
+    }
+    return true;
+}
+
+void sumPositions(std::span<const Entity>, std::span<const PositionComponent> positions, void* user) {
+    float& sum = *static_cast<float*>(user);
+    for (const PositionComponent& p : positions) sum += p.x;
+}
+
+// Cost of visiting a component per entity in the store when only `percent`
+// of the entities were written since the last visit.
+void benchChanged(size_t entities) {
+    HostCore core(1);
+    ModuleAPI api(core.gateway());
+    auto handle = api.registerComponent<PositionComponent>("Position", entities);
+    std::vector<PositionComponent> positions(entities);
+    const EntityRange range = api.createEntities(entities);
+    api.attachComponents<PositionComponent>(range, handle, positions);
+
+    float sum = 0.0f;
+    ChangeCursor cursor;
+    api.updateParallelChanged(handle, cursor, sumPositions, &sum);
+    for (size_t percent : { size_t(0), size_t(1), size_t(10), size_t(100) }) {
+        const size_t stride = percent ? 100 / percent : 0;
+        row("changedPass", "changed", 1, std::to_string(percent) + "%", nsPerOp(entities, 5, [&] {
+            for (size_t i = 0; stride && i < entities; i += stride) api.markChanged(range[i], handle);
+            api.updateParallelChanged(handle, cursor, sumPositions, &sum);
+        }));
+    }
+    row("changedPass", "full", 1, "100%", nsPerOp(entities, 5, [&] {
+        ChangeCursor everything;
+        api.updateParallelChanged(handle, everything, sumPositions, &sum);
+    }));
+    if (sum < 0.0f) std::puts("");
+}
+
+void benchLookup(size_t entities) {
+    HostCore core(1);
+    ModuleAPI api(core.gateway());
+    auto handle = api.registerComponent<PositionComponent>("Position", entities);
+    std::vector<PositionComponent> positions(entities);
+    const EntityRange range = api.createEntities(entities);
+    api.attachComponents<PositionComponent>(range, handle, positions);
+
+    float sink = 0.0f;
+    row("getComponent", "string", 1, std::to_string(entities), nsPerOp(entities, 5, [&] {
+        for (size_t i = 0; i < entities; ++i) sink += api.getComponent<PositionComponent>(range[i], "Position")->x;
+    }));
+    row("getComponent", "handle", 1, std::to_string(entities), nsPerOp(entities, 5, [&] {
+        for (size_t i = 0; i < entities; ++i) sink += api.getComponent(range[i], handle)->x;
+    }));
+    if (sink < 0.0f) std::puts("");
+}
+
+// Allocations per call once the pass is warm (tuners exist, storage sized).
+// Uses a single-threaded host so chunks run inline and only the module
+// side of the call is measured.
+template<typename F>
+double allocationsPerCall(F&& call) {
+    // Several warm-up calls, so every worker has set up its thread-local
+    // buffers before counting starts.
+    for (int i = 0; i < 10; ++i) call();
+    constexpr int kCalls = 100;
+    const size_t before = g_allocations.load(std::memory_order_relaxed);
+    for (int i = 0; i < kCalls; ++i) call();
+    return static_cast<double>(g_allocations.load(std::memory_order_relaxed) - before) / kCalls;
+}
+
+bool benchAllocations(size_t entities, size_t threads) {
+    HostCore core(threads);
+    ModuleAPI api(core.gateway());
+    auto handle = api.registerComponent<PositionComponent>("Position", entities);
+    std::vector<PositionComponent> positions(entities);
+    const EntityRange spawned = api.createEntities(entities);
+    api.attachComponents<PositionComponent>(spawned, handle, positions);
+
+    const double byName = allocationsPerCall([&] { api.updateParallel<PositionComponent>("Position", moveEntity, 1024); });
+    const double byHandle = allocationsPerCall([&] { api.updateParallel(handle, moveEntity, 1024); });
+    const double bound = allocationsPerCall([&] { api.updateParallel<&moveEntity>(handle, 1024); });
+    const double tuned = allocationsPerCall([&] { api.updateParallel<&moveEntity>(handle, AutoChunkSize); });
+    row("allocations", "updateParallel/name", threads, "1024", byName);
+    row("allocations", "updateParallel/handle", threads, "1024", byHandle);
+    row("allocations", "updateParallel/bound", threads, "1024", bound);
+    row("allocations", "updateParallel/bound", threads, "auto", tuned);
+
+    const double reduce = allocationsPerCall([&] { api.reduceParallel(handle, Bounds{}, boundsChunk, mergeBounds); });
+    row("allocations", "reduceParallel", threads, "1024", reduce);
+
+    auto velocities = api.registerComponentSoA<VelocityComponent>("Velocity", entities);
+    api.attachComponents<VelocityComponent>(spawned, velocities, std::vector<VelocityComponent>(entities));
+    const double columns = allocationsPerCall([&] { api.updateParallelColumns(velocities, dampVelocities, nullptr, 1024); });
+    row("allocations", "updateParallelColumns", threads, "1024", columns);
+    std::atomic<size_t> ran{ 0 };
+    const double task = allocationsPerCall([&] {
+        WaitGroup group;
+        api.submit([&ran] { ran.fetch_add(1, std::memory_order_relaxed); }, &group);
+        api.wait(group);
+    });
+    row("allocations", "submit", threads, "1", task);
+
+    const bool ok = byName == 0.0 && byHandle == 0.0 && bound == 0.0 && tuned == 0.0 && reduce == 0.0 &&
+                    columns == 0.0 && task == 0.0;
+    if (!ok) {
+        std::fprintf(stderr, "FractalBench: an updateParallel, reduceParallel or submit path allocated on the heap at %zu threads\n",
+                     threads);
+    }
+    return ok;
+}
+
+void heavyMove(std::span<const Entity>, std::span<PositionComponent> positions, float dt) {
+    for (PositionComponent& p : positions) {
+        for (int k = 0; k < 16; ++k) p.y = std::sin(p.y + dt * static_cast<float>(k));
+        p.x += dt;
+    }
+}
+
+// Frame times of an expensive system run in full every frame vs spread
+// over frames with a 1 ms budget.
+void benchBudgeted(size_t entities) {
+    for (TriggerType trigger : { TriggerType::Always, TriggerType::Budgeted }) {
+        HostCore core(1);
+        ModuleAPI api(core.gateway());
+        auto handle = api.registerComponent<PositionComponent>("Position", entities);
+        std::vector<PositionComponent> positions(entities);
+        api.attachComponents<PositionComponent>(api.createEntities(entities), handle, positions);
+        SystemConfig desc;
+        desc.systemName = "HeavyMove";
+        desc.trigger = trigger;
+        desc.budget = 0.001f;
+        api.registerSystem(handle, heavyMove, desc, 1024);
+
+        constexpr int kFrames = 60;
+        double total = 0.0, worst = 0.0;
+        for (int f = 0; f < kFrames; ++f) {
+            const auto start = BenchClock::now();
+            core.runFrame(1.0f / 60.0f);
+            const double ns = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+            total += ns;
+            worst = std::max(worst, ns);
+        }
+        const char* variant = trigger == TriggerType::Always ? "always" : "budgeted_1ms";
+        row("systemFrame", variant, 1, "avg", total / kFrames);
+        row("systemFrame", variant, 1, "max", worst);
+    }
+}
+
+// Fan-out of small tasks through the gateway, joined with a wait group and
+// a continuation.
+void benchTasks(size_t tasks, size_t threads) {
+    HostCore core(threads);
+    ModuleAPI api(core.gateway());
+    std::atomic<uint64_t> sum{ 0 };
+    row("tasks", "submit+wait", threads, std::to_string(tasks), nsPerOp(tasks, 5, [&] {
+        WaitGroup group;
+        for (size_t i = 0; i < tasks; ++i) api.submit([&sum] { sum.fetch_add(1, std::memory_order_relaxed); }, &group);
+        api.wait(group);
+    }));
+    row("tasks", "continuation", threads, std::to_string(tasks), nsPerOp(tasks, 5, [&] {
+        WaitGroup group;
+        WaitGroup done;
+        for (size_t i = 0; i < tasks; ++i) api.submit([&sum] { sum.fetch_add(1, std::memory_order_relaxed); }, &group);
+        api.continueWith(group, [&sum] { sum.fetch_add(1, std::memory_order_relaxed); }, &done);
+        api.wait(done);
+    }));
+    if (sum.load() == 0) std::puts("");
+}
+
+// Cost of one frame (16 ms of clock) of the timer wheel with `timers`
+// interval tasks of 100-1000 ms registered.
+void benchTimers(size_t timers) {
+    const auto start = TimerWheel::Clock::now();
+    TimerWheel wheel(start);
+    uint64_t fired = 0;
+    for (size_t i = 0; i < timers; ++i) {
+        const TickTaskDesc desc{ static_cast<uint32_t>(100 + i % 901), 0, false };
+        wheel.add([&fired] { ++fired; }, desc, start);
+    }
+    constexpr int kFrames = 600;
+    int frame = 0;
+    const double ns = nsPerOp(1, kFrames, [&] {
+        ++frame;
+        wheel.advance(start + std::chrono::milliseconds(16 * frame), [](TimerWheel::Timer& timer) { timer.task(); });
+    });
+    row("timerWheel", "frame", 1, std::to_string(timers), ns);
+    if (fired == 0) std::puts("");
+}
+
+void onPing(const PingEvent& e, void* user) {
+    *static_cast<uint64_t*>(user) += e.value;
+}
+
+void onPingBatch(std::span<const PingEvent> events, void* user) {
+    for (const PingEvent& e : events) *static_cast<uint64_t*>(user) += e.value;
+}
+
+void benchEvents(size_t events) {
+    HostCore core(1);
+    ModuleAPI api(core.gateway());
+    uint64_t sum = 0;
+    auto ping = api.registerEvent<PingEvent>("Ping");
+    api.subscribe(ping, onPing, &sum);
+
+    row("event", "emit", 1, std::to_string(events), nsPerOp(events, 5, [&] {
+        for (size_t i = 0; i < events; ++i) api.emitEvent(ping, PingEvent{ 1 });
+    }));
+    row("event", "push", 1, std::to_string(events), nsPerOp(events, 5, [&] {
+        for (size_t i = 0; i < events; ++i) api.pushEvent(ping, PingEvent{ 1 });
+        core.runFrame(0.0f);
+    }));
+
+    auto batch = api.registerEvent<PingEvent>("PingBatch");
+    EventStream<PingEvent>& stream = api.eventStream(batch, events);
+    api.subscribeBatch(batch, onPingBatch, &sum);
+    row("event", "stream", 1, std::to_string(events), nsPerOp(events, 5, [&] {
+        for (size_t i = 0; i < events; ++i) stream.emplace(PingEvent{ 1 });
+        core.runFrame(0.0f);
+    }));
+    if (sum == 0) std::puts("");
+}
+
+// A whole non-negative decimal number; signs, trailing text and overflow fail.
+bool parseCount(const char* text, size_t& out) {
+    const char* end = text + std::strlen(text);
+    const auto [ptr, ec] = std::from_chars(text, end, out);
+    return ec == std::errc() && ptr == end;
+}
+
+int usage(const char* program) {
+    std::fprintf(stderr, "usage: %s [entities] [maxThreads]\n"
+                         "  entities    entities per benchmark, at least 1 (default 100000)\n"
+                         "  maxThreads  highest thread count measured, at least 1 (default: hardware threads)\n",
+                 program);
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t entities = 100000;
+    size_t maxThreads = std::thread::hardware_concurrency();
+    if (argc > 3) return usage(argv[0]);
+    if (argc > 1 && (!parseCount(argv[1], entities) || entities == 0)) return usage(argv[0]);
+    if (argc > 2 && (!parseCount(argv[2], maxThreads) || maxThreads == 0)) return usage(argv[0]);
+
+    std::puts("benchmark,variant,threads,param,ns_per_op");
+    benchCreation(entities);
+    const bool churnOk = benchChurn(entities);
+    benchSnapshot(entities);
+    for (size_t threads = 1; threads <= (maxThreads ? maxThreads : 1); threads *= 2) benchUpdate(entities, threads);
+    bool deterministic = true;
+    const double reference = benchReduce(entities, 1);
+    for (size_t threads = 2; threads <= maxThreads; threads *= 2) deterministic &= benchReduce(entities, threads) == reference;
+    if (!deterministic) std::fprintf(stderr, "FractalBench: reduceParallel result depends on the thread count\n");
+    bool spatialOk = true;
+    for (size_t n : { size_t(10000), size_t(100000), size_t(1000000) }) spatialOk &= benchSpatial(n, maxThreads ? maxThreads : 1);
+    if (!spatialOk) std::fprintf(stderr, "FractalBench: spatial index disagrees with a full scan\n");
+    benchLookup(entities);
+    benchChanged(entities);
+    benchEvents(entities);
+    benchTasks(entities, maxThreads ? maxThreads : 1);
+    benchBudgeted(entities);
+    for (size_t timers : { size_t(1000), size_t(10000), size_t(100000) }) benchTimers(timers);
+    bool allocationFree = benchAllocations(entities, 1);
+    allocationFree &= benchAllocations(entities, std::max<size_t>(maxThreads, 2));
+    return allocationFree && churnOk && deterministic && spatialOk ? 0 : 1;
+}
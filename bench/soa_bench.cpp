@@ -0,0 +1,91 @@
+// AoS vs SoA throughput on the example module's Position workload.
+// Prints one CSV row per layout: layout,entities,passes,ns_per_entity
+
+#include "headers/FractalCORE_simd.h"
+#include "headers/FractalCORE_soa.h"
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <vector>
+
+struct PositionComponent {
+    float x = 0.0f;
+    float y = 0.0f;
+};
+FRACTAL_SOA_LAYOUT(PositionComponent, &PositionComponent::x, &PositionComponent::y);
+
+namespace {
+
+constexpr size_t kChunk = 1024;
+constexpr float kStep = 0.016f * 10.0f;
+
+struct AlignedFree {
+    void operator()(float* p) const { ::operator delete[](p, std::align_val_t(32)); }
+};
+using Column = std::unique_ptr<float[], AlignedFree>;
+
+Column makeColumn(size_t n) {
+    return Column(new (std::align_val_t(32)) float[n]());
+}
+
+template<typename F>
+double nsPerEntity(size_t entities, int passes, F&& pass) {
+    pass(); // warm-up
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < passes; ++i) pass();
+    const auto end = std::chrono::steady_clock::now();
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    return ns / (static_cast<double>(entities) * passes);
+}
+
+void runAoS(size_t entities, int passes) {
+    std::vector<PositionComponent> positions(entities);
+    const double ns = nsPerEntity(entities, passes, [&] {
+        for (size_t start = 0; start < entities; start += kChunk) {
+            const size_t end = std::min(entities, start + kChunk);
+            for (size_t i = start; i < end; ++i) positions[i].x += kStep;
+        }
+    });
+    std::printf("aos,%zu,%d,%.4f\n", entities, passes, ns);
+}
+
+void runSoA(size_t entities, int passes) {
+    Column xs = makeColumn(entities);
+    Column ys = makeColumn(entities);
+    void* columns[soaFieldCount<PositionComponent>()] = { xs.get(), ys.get() };
+
+    const double ns = nsPerEntity(entities, passes, [&] {
+        for (size_t start = 0; start < entities; start += kChunk) {
+            const size_t count = std::min(kChunk, entities - start);
+            void* chunkColumns[] = { static_cast<float*>(columns[0]) + start, static_cast<float*>(columns[1]) + start };
+            SoAChunk<PositionComponent> chunk(nullptr, chunkColumns, count);
+            simd::addScalar(chunk.column<&PositionComponent::x>(), kStep);
+        }
+    });
+    std::printf("soa_simd%zu,%zu,%d,%.4f\n", simd::kFloatLanes, entities, passes, ns);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int passes = 200;
+    if (argc > 1) {
+        const char* end = argv[1] + std::strlen(argv[1]);
+        const auto [ptr, ec] = std::from_chars(argv[1], end, passes);
+        if (argc > 2 || ec != std::errc() || ptr != end || passes <= 0) {
+            std::fprintf(stderr, "usage: %s [passes]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::printf("layout,entities,passes,ns_per_entity\n");
+    for (size_t entities : { size_t(10000), size_t(100000), size_t(1000000) }) {
+        runAoS(entities, passes);
+        runSoA(entities, passes);
+    }
+    return 0;
+}
@@ -0,0 +1,940 @@
+#include "HostCore.h"
+#include "headers/FractalCORE_handles.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+// The module headers only declare ComponentData's storage management; the
+// core owns the element buffer.
+ComponentData::ComponentData(size_t elemSize, size_t cap) : elementSize(elemSize), capacity(cap) {
+    if (elementSize && capacity) data = std::malloc(elementSize * capacity);
+    if (data == nullptr) capacity = 0;
+}
+
+ComponentData::~ComponentData() {
+    std::free(data);
+}
+
+namespace {
+
+HostCore* host(void* api) {
+    return static_cast<HostCore*>(api);
+}
+
+constexpr size_t kColumnAlignment = 32;
+
+} // namespace
+
+void HostCore::AlignedFree::operator()(unsigned char* p) const {
+    ::operator delete[](p, std::align_val_t(kColumnAlignment));
+}
+
+HostCore::HostCore(size_t threads) : m_pool(threads), m_scheduler(m_pool) {
+    FractalCORE_Gateway& gw = m_gateway;
+    gw.api = this;
+    gw.stop = &gwStop;
+    gw.getDeltaTime = &gwGetDeltaTime;
+    gw.getEngineClock = &gwGetEngineClock;
+    gw.enqueueTask = &gwEnqueueTask;
+    gw.registerIntervalTask = &gwRegisterIntervalTask;
+    gw.createEntity = &gwCreateEntity;
+    gw.registerComponent = &gwRegisterComponent;
+    gw.attachComponent = &gwAttachComponent;
+    gw.removeComponent = &gwRemoveComponent;
+    gw.getComponent = &gwGetComponent;
+    gw.hasComponent = &gwHasComponent;
+    gw.getComponentData = &gwGetComponentData;
+    gw.registerGroup = &gwRegisterGroup;
+    gw.registerSystem = &gwRegisterSystem;
+    gw.registerSystemInLoop = &gwRegisterSystemInLoop;
+    gw.updateParallel = &gwUpdateParallel;
+    gw.updateParallelGroup = &gwUpdateParallelGroup;
+    gw.registerEvent = &gwRegisterEvent;
+    gw.pushEvent = &gwPushEvent;
+    gw.emitEvent = &gwEmitEvent;
+    gw.subscribe = &gwSubscribe;
+    gw.abiMagic = kGatewayAbiMagic;
+    gw.structSize = sizeof(FractalCORE_Gateway);
+    gw.updateParallelChunks = &gwUpdateParallelChunks;
+    gw.registerComponentById = &gwRegisterComponentById;
+    gw.attachComponentById = &gwAttachComponentById;
+    gw.removeComponentById = &gwRemoveComponentById;
+    gw.getComponentById = &gwGetComponentById;
+    gw.hasComponentById = &gwHasComponentById;
+    gw.getComponentDataById = &gwGetComponentDataById;
+    gw.updateParallelChunksById = &gwUpdateParallelChunksById;
+    gw.registerEventById = &gwRegisterEventById;
+    gw.createEntities = &gwCreateEntities;
+    gw.attachComponentsById = &gwAttachComponentsById;
+    gw.attachComponentFillById = &gwAttachComponentFillById;
+    gw.removeComponentsById = &gwRemoveComponentsById;
+    gw.registerComponentSoAById = &gwRegisterComponentSoAById;
+    gw.updateParallelColumnsById = &gwUpdateParallelColumnsById;
+    gw.registerGroupById = &gwRegisterGroupById;
+    gw.updateParallelGroupById = &gwUpdateParallelGroupById;
+    gw.destroyEntity = &gwDestroyEntity;
+    gw.destroyEntities = &gwDestroyEntities;
+    gw.isAlive = &gwIsAlive;
+    gw.compactStorage = &gwCompactStorage;
+    gw.updateParallelChangedById = &gwUpdateParallelChangedById;
+    gw.markChangedById = &gwMarkChangedById;
+    gw.readComponentById = &gwReadComponentById;
+    gw.saveSnapshot = &gwSaveSnapshot;
+    gw.loadSnapshot = &gwLoadSnapshot;
+    gw.readParallelChunksById = &gwReadParallelChunksById;
+    gw.submitTask = &gwSubmitTask;
+    gw.continueWith = &gwContinueWith;
+    gw.waitGroup = &gwWaitGroup;
+    gw.scheduleTickTask = &gwScheduleTickTask;
+    gw.cancelTickTask = &gwCancelTickTask;
+    gw.updateParallelRangeById = &gwUpdateParallelRangeById;
+    gw.registerSystemAccess = &gwRegisterSystemAccess;
+    gw.workerCount = &gwWorkerCount;
+}
+
+HostCore::~HostCore() {
+    // Mapped element sections belong to the snapshot, not to malloc.
+    for (auto& [id, c] : m_components) {
+        if (c->mapping) c->store->data = nullptr;
+    }
+}
+
+// --- Frame ---
+
+void HostCore::runFrame(float dt) {
+    m_dt = dt;
+
+    std::vector<std::function<void()>> mainTasks;
+    {
+        std::lock_guard<std::mutex> lock(m_taskMutex);
+        mainTasks.swap(m_mainTasks);
+    }
+    for (auto& task : mainTasks) task();
+
+    m_timers.advance(std::chrono::steady_clock::now(), [this](TimerWheel::Timer& timer) {
+        if (!timer.isBackTask) {
+            timer.task();
+            return;
+        }
+        timer.running.store(true, std::memory_order_relaxed);
+        m_pool.submit([&timer] {
+            timer.task();
+            timer.running.store(false, std::memory_order_release);
+        });
+    });
+
+    m_scheduler.runFrame(dt);
+
+    std::vector<QueuedEvent> events;
+    {
+        std::lock_guard<std::mutex> lock(m_eventMutex);
+        events.swap(m_eventQueue);
+    }
+    for (QueuedEvent& ev : events) dispatch(ev.id, ev.bytes.data(), ev.bytes.size());
+
+    m_clock.advanceFrame();
+    if (m_compactionInterval && m_clock.frame() % m_compactionInterval == 0) compact();
+}
+
+// --- Storage ---
+
+HostCore::HostComponent* HostCore::find(uint32_t id) {
+    auto it = m_components.find(id);
+    return it != m_components.end() ? it->second.get() : nullptr;
+}
+
+HostCore::HostComponent* HostCore::find(const std::string& name) {
+    auto it = m_componentIds.find(name);
+    return it != m_componentIds.end() ? find(it->second) : nullptr;
+}
+
+bool HostCore::addComponent(uint32_t id, const char* name, size_t elementSize, size_t capacity,
+                            const FieldDesc* fields, size_t fieldCount) {
+    if (HostComponent* existing = find(id)) return existing->name == name;
+
+    auto c = std::make_unique<HostComponent>();
+    c->name = name;
+    c->id = id;
+    c->soa = fields != nullptr;
+    c->store = std::make_unique<ComponentData>(elementSize, c->soa ? 0 : capacity);
+    c->store->elementSize = elementSize;
+    if (c->soa) {
+        c->fields.assign(fields, fields + fieldCount);
+        c->columns.resize(fieldCount);
+    } else {
+        c->versions.resize((c->store->capacity + kChangeBlock - 1) / kChangeBlock, 0);
+    }
+    m_componentIds[c->name] = id;
+    HostComponent& ref = *c;
+    m_components.emplace(id, std::move(c));
+    if (ref.soa) reserve(ref, capacity);
+    return true;
+}
+
+void HostCore::reserve(HostComponent& c, size_t count) {
+    ComponentData& cd = *c.store;
+    if (c.soa) {
+        if (count <= c.columnCapacity) return;
+        const size_t newCap = std::max(count, c.columnCapacity * 2);
+        for (size_t f = 0; f < c.fields.size(); ++f) {
+            Column column(new (std::align_val_t(kColumnAlignment)) unsigned char[newCap * c.fields[f].size]);
+            if (c.columns[f]) std::memcpy(column.get(), c.columns[f].get(), cd.dense.size() * c.fields[f].size);
+            c.columns[f] = std::move(column);
+        }
+        c.columnCapacity = newCap;
+        cd.dense.reserve(newCap);
+        c.versions.resize((newCap + kChangeBlock - 1) / kChangeBlock, 0);
+        return;
+    }
+    if (count <= cd.capacity) return;
+    const size_t newCap = std::max(count, cd.capacity * 2);
+    void* grown;
+    if (c.mapping) {
+        // Restored from a snapshot: move into heap storage before growing.
+        grown = std::malloc(newCap * cd.elementSize);
+        if (grown) std::memcpy(grown, cd.data, cd.dense.size() * cd.elementSize);
+    } else {
+        grown = std::realloc(cd.data, newCap * cd.elementSize);
+    }
+    if (!grown) throw std::bad_alloc();
+    c.mapping.reset();
+    cd.data = grown;
+    cd.capacity = newCap;
+    cd.dense.reserve(newCap);
+    c.versions.resize((newCap + kChangeBlock - 1) / kChangeBlock, 0);
+}
+
+void* HostCore::elementAt(HostComponent& c, size_t index) {
+    if (c.soa) return nullptr;
+    return static_cast<unsigned char*>(c.store->data) + index * c.store->elementSize;
+}
+
+// For lookups that hand out an element pointer, which SoA storage can't.
+void* HostCore::requireElement(HostComponent& c, size_t index) {
+    if (c.soa) throw std::logic_error("HostCore: '" + c.name + "' is stored as columns and has no element to point at");
+    return elementAt(c, index);
+}
+
+void HostCore::writeElement(HostComponent& c, size_t index, const void* bytes) {
+    if (!c.soa) {
+        std::memcpy(elementAt(c, index), bytes, c.store->elementSize);
+        return;
+    }
+    const auto* src = static_cast<const unsigned char*>(bytes);
+    for (size_t f = 0; f < c.fields.size(); ++f) {
+        std::memcpy(c.columns[f].get() + index * c.fields[f].size, src + c.fields[f].offset, c.fields[f].size);
+    }
+}
+
+void HostCore::moveElement(HostComponent& c, size_t from, size_t to) {
+    if (!c.soa) {
+        std::memcpy(elementAt(c, to), elementAt(c, from), c.store->elementSize);
+        return;
+    }
+    for (size_t f = 0; f < c.fields.size(); ++f) {
+        const size_t size = c.fields[f].size;
+        std::memcpy(c.columns[f].get() + to * size, c.columns[f].get() + from * size, size);
+    }
+}
+
+void HostCore::swapElements(HostComponent& c, size_t a, size_t b) {
+    if (a == b) return;
+    ComponentData& cd = *c.store;
+    std::swap(cd.dense[a], cd.dense[b]);
+    c.sparse.set(Entity{ cd.dense[a] }.index(), static_cast<uint32_t>(a));
+    c.sparse.set(Entity{ cd.dense[b] }.index(), static_cast<uint32_t>(b));
+    touch(c, a);
+    touch(c, b);
+
+    if (!c.soa) {
+        auto* first = static_cast<unsigned char*>(elementAt(c, a));
+        std::swap_ranges(first, first + cd.elementSize, static_cast<unsigned char*>(elementAt(c, b)));
+        return;
+    }
+    for (size_t f = 0; f < c.fields.size(); ++f) {
+        const size_t size = c.fields[f].size;
+        std::swap_ranges(c.columns[f].get() + a * size, c.columns[f].get() + (a + 1) * size,
+                         c.columns[f].get() + b * size);
+    }
+}
+
+uint32_t HostCore::indexOf(const HostComponent& c, Entity e) const {
+    // The dense entry holds the full ID, so a stale generation misses here.
+    const uint32_t index = c.sparse.get(e.index());
+    return index != kNone && c.store->dense[index] == e.id ? index : kNone;
+}
+
+void HostCore::attach(HostComponent& c, Entity e, const void* bytes) {
+    if (!isAlive(e)) return;
+    ComponentData& cd = *c.store;
+    const uint32_t existing = indexOf(c, e);
+    if (existing != kNone) {
+        writeElement(c, existing, bytes);
+        touch(c, existing);
+        return;
+    }
+    reserve(c, cd.dense.size() + 1);
+    const size_t index = cd.dense.size();
+    cd.dense.push_back(e.id);
+    c.sparse.set(e.index(), static_cast<uint32_t>(index));
+    writeElement(c, index, bytes);
+    touch(c, index);
+    markGroupsDirty(c);
+}
+
+void HostCore::remove(HostComponent& c, Entity e) {
+    ComponentData& cd = *c.store;
+    const uint32_t index = indexOf(c, e);
+    if (index == kNone) return;
+    const size_t last = cd.dense.size() - 1;
+    if (index != last) {
+        moveElement(c, last, index);
+        cd.dense[index] = cd.dense[last];
+        c.sparse.set(Entity{ cd.dense[index] }.index(), index);
+        touch(c, index);
+    }
+    cd.dense.pop_back();
+    c.sparse.set(e.index(), kNone);
+    markGroupsDirty(c);
+}
+
+// Stamps may come from several workers at once (getComponent inside a
+// parallel pass), hence atomic_ref; they all store the same tick.
+void HostCore::touch(HostComponent& c, size_t index) {
+    const uint64_t tick = m_changeTick.load(std::memory_order_relaxed);
+    std::atomic_ref<uint64_t>(c.versions[index / kChangeBlock]).store(tick, std::memory_order_relaxed);
+}
+
+void HostCore::touchRange(HostComponent& c, size_t start, size_t end) {
+    if (start >= end) return;
+    const uint64_t tick = m_changeTick.load(std::memory_order_relaxed);
+    for (size_t b = start / kChangeBlock; b <= (end - 1) / kChangeBlock; ++b) {
+        std::atomic_ref<uint64_t>(c.versions[b]).store(tick, std::memory_order_relaxed);
+    }
+}
+
+bool HostCore::isAlive(Entity e) const {
+    const uint32_t index = e.index();
+    return index < m_slots.size() && m_slots[index].alive && m_slots[index].generation == e.generation();
+}
+
+size_t HostCore::sparsePageCount() const {
+    size_t pages = 0;
+    for (const auto& [id, c] : m_components) pages += c->sparse.allocatedPages();
+    return pages;
+}
+
+// Drops sparse pages that no longer map any entity and gives back dense
+// capacity once a component has shrunk to a quarter of it.
+size_t HostCore::compact() {
+    size_t freedPages = 0;
+    for (auto& [id, c] : m_components) {
+        ComponentData& cd = *c->store;
+        freedPages += c->sparse.compact();
+        if (c->soa || c->mapping || cd.capacity < 64 || cd.dense.size() * 4 > cd.capacity) continue;
+
+        const size_t newCap = std::max<size_t>(cd.dense.size() * 2, 64);
+        if (void* shrunk = std::realloc(cd.data, newCap * cd.elementSize)) {
+            cd.data = shrunk;
+            cd.capacity = newCap;
+            c->versions.resize((newCap + kChangeBlock - 1) / kChangeBlock);
+            c->versions.shrink_to_fit();
+        }
+        cd.dense.shrink_to_fit();
+    }
+    return freedPages;
+}
+
+void HostCore::markGroupsDirty(HostComponent& c) {
+    for (size_t g : c.groups) m_groups[g].dirty = true;
+}
+
+// --- Groups ---
+
+HostCore::HostGroup& HostCore::groupFor(const uint32_t* ids, size_t count) {
+    for (HostGroup& group : m_groups) {
+        if (group.ids.size() == count && std::equal(group.ids.begin(), group.ids.end(), ids)) return group;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        HostComponent* c = find(ids[i]);
+        if (!c) throw std::runtime_error("HostCore: group member is not a registered component");
+        c->groups.push_back(m_groups.size());
+    }
+    m_groups.push_back(HostGroup{ std::vector<uint32_t>(ids, ids + count), 0, true });
+    return m_groups.back();
+}
+
+// Moves the entities owning every member to the front of each member's
+// dense array, in the same order, so index i means the same entity everywhere.
+// Other groups sharing a reordered member have to repack.
+void HostCore::pack(HostGroup& group) {
+    if (!group.dirty) return;
+    std::vector<HostComponent*> members;
+    for (uint32_t id : group.ids) members.push_back(find(id));
+
+    HostComponent* smallest = *std::min_element(members.begin(), members.end(), [](auto* a, auto* b) {
+        return a->store->dense.size() < b->store->dense.size();
+    });
+    const std::vector<uint32_t> candidates = smallest->store->dense;
+
+    size_t packed = 0;
+    std::vector<bool> moved(members.size());
+    for (uint32_t id : candidates) {
+        const Entity e{ id };
+        const bool inAll = std::all_of(members.begin(), members.end(), [&](auto* m) { return indexOf(*m, e) != kNone; });
+        if (!inAll) continue;
+        for (size_t i = 0; i < members.size(); ++i) {
+            const uint32_t index = indexOf(*members[i], e);
+            if (index == packed) continue;
+            swapElements(*members[i], index, packed);
+            moved[i] = true;
+        }
+        ++packed;
+    }
+    for (size_t i = 0; i < members.size(); ++i) {
+        if (moved[i]) markGroupsDirty(*members[i]);
+    }
+    group.size = packed;
+    group.dirty = false;
+}
+
+// --- Iteration ---
+
+template<typename Body>
+void HostCore::parallelFor(size_t count, size_t chunkSize, const Body& body) {
+    if (count == 0) return;
+    if (chunkSize == 0 || chunkSize >= count || m_pool.threadCount() == 1) {
+        const size_t step = chunkSize ? chunkSize : count;
+        for (size_t start = 0; start < count; start += step) body(start, std::min(count, start + step));
+        return;
+    }
+    WaitGroup group;
+    for (size_t start = 0; start < count; start += chunkSize) {
+        const size_t end = std::min(count, start + chunkSize);
+        m_pool.submit([&body, start, end] { body(start, end); }, &group);
+    }
+    m_pool.wait(group);
+}
+
+template<typename Body>
+void HostCore::withRows(HostComponent& c, size_t start, size_t count, bool writeBack, const Body& body) {
+    ComponentData& cd = *c.store;
+    const auto* entities = reinterpret_cast<const Entity*>(cd.dense.data()) + start;
+    if (!c.soa) {
+        body(entities, static_cast<unsigned char*>(cd.data) + start * cd.elementSize);
+        return;
+    }
+    // One buffer per nesting level: the body may start another pass on this
+    // thread, or run queued chunks while it waits, before it returns.
+    thread_local std::deque<std::vector<unsigned char>> buffers;
+    thread_local size_t depth = 0;
+    if (buffers.size() == depth) buffers.emplace_back();
+    std::vector<unsigned char>& rows = buffers[depth];
+    rows.resize(count * cd.elementSize);
+    for (size_t f = 0; f < c.fields.size(); ++f) {
+        const FieldDesc& field = c.fields[f];
+        const unsigned char* column = c.columns[f].get() + start * field.size;
+        for (size_t i = 0; i < count; ++i) {
+            std::memcpy(rows.data() + i * cd.elementSize + field.offset, column + i * field.size, field.size);
+        }
+    }
+
+    struct Level {
+        size_t& depth;
+        explicit Level(size_t& d) : depth(d) { ++depth; }
+        ~Level() { --depth; }
+    } level(depth);
+    body(entities, rows.data());
+    if (!writeBack) return;
+    for (size_t f = 0; f < c.fields.size(); ++f) {
+        const FieldDesc& field = c.fields[f];
+        unsigned char* column = c.columns[f].get() + start * field.size;
+        for (size_t i = 0; i < count; ++i) {
+            std::memcpy(column + i * field.size, rows.data() + i * cd.elementSize + field.offset, field.size);
+        }
+    }
+}
+
+void HostCore::chunks(HostComponent& c, void (*func)(const Entity*, void*, size_t, void*), void* user,
+                      size_t chunkSize) {
+    touchRange(c, 0, c.store->dense.size());
+    parallelFor(c.store->dense.size(), chunkSize, [&](size_t start, size_t end) {
+        withRows(c, start, end - start, true, [&](const Entity* entities, unsigned char* rows) {
+            func(entities, rows, end - start, user);
+        });
+    });
+}
+
+void HostCore::dispatch(uint32_t id, const void* data, size_t size) {
+    auto it = m_subscribers.find(id);
+    if (it == m_subscribers.end()) return;
+    const EventData eventData{ const_cast<void*>(data), size };
+    for (const Subscriber& s : it->second) s.func(id, eventData, s.userData);
+}
+
+// --- Gateway: core ---
+
+void HostCore::gwStop(void* api) { host(api)->m_running = false; }
+float HostCore::gwGetDeltaTime(void* api) { return host(api)->m_dt; }
+Clock& HostCore::gwGetEngineClock(void* api) { return host(api)->m_clock; }
+
+void HostCore::gwEnqueueTask(void* api, const Task& task) {
+    HostCore* core = host(api);
+    if (task.isBackTask) {
+        core->m_pool.submit(task.func);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(core->m_taskMutex);
+    core->m_mainTasks.push_back(task.func);
+}
+
+void HostCore::gwRegisterIntervalTask(void* api, const TickTask& task) {
+    if (!task.active) return;
+    // executionsRemaining == 0 means "repeat forever", as in TickTaskDesc.
+    const TickTaskDesc desc{ static_cast<uint32_t>(task.intervalMs.count()),
+                             static_cast<uint32_t>(task.executionsRemaining), task.isBackTask };
+    host(api)->m_timers.add(InlineTask(task.func), desc);
+}
+
+void HostCore::gwSubmitTask(void* api, InlineTask* task, WaitGroup* group) {
+    host(api)->m_pool.submit(std::move(*task), group);
+}
+
+void HostCore::gwContinueWith(void* api, WaitGroup* group, InlineTask* task, WaitGroup* next) {
+    host(api)->m_pool.continueWith(*group, std::move(*task), next);
+}
+
+void HostCore::gwWaitGroup(void* api, WaitGroup* group) {
+    host(api)->m_pool.wait(*group);
+}
+
+uint64_t HostCore::gwScheduleTickTask(void* api, InlineTask* task, const TickTaskDesc* desc) {
+    return host(api)->m_timers.add(std::move(*task), *desc);
+}
+
+bool HostCore::gwCancelTickTask(void* api, uint64_t id) {
+    return host(api)->m_timers.cancel(id);
+}
+
+// --- Gateway: entities & components ---
+
+Entity HostCore::gwCreateEntity(void* api) {
+    HostCore* core = host(api);
+    while (!core->m_freeSlots.empty()) {
+        // Oldest free slot first, so a slot's generation wraps as late as possible.
+        const uint32_t index = core->m_freeSlots.front();
+        core->m_freeSlots.pop_front();
+        EntitySlot& slot = core->m_slots[index];
+        if (slot.alive) {
+            // Taken by a bulk creation since it was queued.
+            if (core->m_freeStale) --core->m_freeStale;
+            continue;
+        }
+        core->m_freeRuns.remove(index);
+        slot.alive = true;
+        ++core->m_liveEntities;
+        return Entity::make(index, slot.generation);
+    }
+    return gwCreateEntities(api, 1);
+}
+
+// Bulk creation must return consecutive IDs: it reuses a run of free slots
+// that share a generation when one is long enough, else takes fresh slots.
+Entity HostCore::gwCreateEntities(void* api, size_t count) {
+    HostCore* core = host(api);
+    uint32_t reused = 0;
+    uint32_t generation = 0;
+    if (count && core->m_freeRuns.take(count, reused, generation)) {
+        for (size_t i = 0; i < count; ++i) core->m_slots[reused + i].alive = true;
+        core->m_liveEntities += count;
+        core->m_freeStale += count;
+        if (core->m_freeStale > core->m_freeSlots.size() / 2) core->pruneFreeSlots();
+        return Entity::make(reused, generation);
+    }
+    const size_t first = core->m_slots.size();
+    if (first + count > Entity::kIndexMask) throw std::runtime_error("HostCore: entity index space exhausted");
+    core->m_slots.resize(first + count, EntitySlot{ 0, true });
+    core->m_liveEntities += count;
+    return Entity::make(static_cast<uint32_t>(first), 0);
+}
+
+void HostCore::gwDestroyEntity(void* api, Entity e) {
+    gwDestroyEntities(api, &e, 1);
+}
+
+void HostCore::gwDestroyEntities(void* api, const Entity* entities, size_t count) {
+    HostCore* core = host(api);
+    for (auto& [id, c] : core->m_components) {
+        for (size_t i = 0; i < count; ++i) {
+            if (core->isAlive(entities[i])) core->remove(*c, entities[i]);
+        }
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (!core->isAlive(entities[i])) continue; // stale or listed twice
+        core->freeSlot(entities[i].index());
+    }
+}
+
+// The generation is 8 bits, so it wraps after 256 reuses of a slot.
+void HostCore::freeSlot(uint32_t index) {
+    EntitySlot& slot = m_slots[index];
+    slot.alive = false;
+    slot.generation = (slot.generation + 1) & Entity::kMaxGeneration;
+    m_freeSlots.push_back(index);
+    m_freeRuns.add(index, slot.generation);
+    --m_liveEntities;
+}
+
+// Drops queue entries for slots that are alive again, and repeats of slots
+// freed a second time, keeping the first occurrence of each free slot.
+void HostCore::pruneFreeSlots() {
+    std::vector<bool> queued(m_slots.size());
+    std::erase_if(m_freeSlots, [&](uint32_t index) {
+        if (m_slots[index].alive || queued[index]) return true;
+        queued[index] = true;
+        return false;
+    });
+    m_freeStale = 0;
+}
+
+// Rebuilds the free runs from the slot table, e.g. after a snapshot load.
+void HostCore::rebuildFreeSlots() {
+    pruneFreeSlots();
+    m_freeRuns.clear();
+    for (uint32_t index = 0; index < m_slots.size(); ++index) {
+        if (!m_slots[index].alive) m_freeRuns.add(index, m_slots[index].generation);
+    }
+}
+
+bool HostCore::gwIsAlive(void* api, Entity e) {
+    return host(api)->isAlive(e);
+}
+
+size_t HostCore::gwCompactStorage(void* api) {
+    return host(api)->compact();
+}
+
+void HostCore::gwRegisterComponent(void* api, const std::string& name, size_t elementSize, size_t capacity) {
+    host(api)->addComponent(hashName(name), name.c_str(), elementSize, capacity, nullptr, 0);
+}
+
+bool HostCore::gwRegisterComponentById(void* api, uint32_t id, const char* name, size_t elementSize, size_t capacity) {
+    return host(api)->addComponent(id, name, elementSize, capacity, nullptr, 0);
+}
+
+bool HostCore::gwRegisterComponentSoAById(void* api, uint32_t id, const char* name, size_t elementSize,
+                                          const FieldDesc* fields, size_t fieldCount, size_t capacity) {
+    if (fieldCount > kMaxColumns) {
+        throw std::invalid_argument("HostCore: '" + std::string(name) + "' has more than " +
+                                    std::to_string(kMaxColumns) + " fields");
+    }
+    for (size_t f = 0; f < fieldCount; ++f) {
+        if (fields[f].offset + fields[f].size > elementSize) {
+            throw std::invalid_argument("HostCore: field of '" + std::string(name) + "' lies outside its struct");
+        }
+    }
+    return host(api)->addComponent(id, name, elementSize, capacity, fields, fieldCount);
+}
+
+void HostCore::gwAttachComponent(void* api, Entity e, const std::string& name, void* data) {
+    if (HostComponent* c = host(api)->find(name)) host(api)->attach(*c, e, data);
+}
+
+void HostCore::gwAttachComponentById(void* api, Entity e, uint32_t id, void* data) {
+    if (HostComponent* c = host(api)->find(id)) host(api)->attach(*c, e, data);
+}
+
+void HostCore::gwAttachComponentsById(void* api, uint32_t id, const Entity* entities, const void* data, size_t count) {
+    HostCore* core = host(api);
+    HostComponent* c = core->find(id);
+    if (!c || count == 0) return;
+    ComponentData& cd = *c->store;
+    core->reserve(*c, cd.dense.size() + count);
+
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    size_t i = 0;
+    if (!c->soa) {
+        // Common spawn path: append the run of new entities and copy their
+        // payload in one go. The check runs against the growing array, so
+        // an entity repeated within the batch ends the run like a dead or
+        // already attached one, and the rest goes through attach().
+        const size_t base = cd.dense.size();
+        for (; i < count && core->isAlive(entities[i]) && core->indexOf(*c, entities[i]) == kNone; ++i) {
+            cd.dense.push_back(entities[i].id);
+            c->sparse.set(entities[i].index(), static_cast<uint32_t>(base + i));
+        }
+        if (i > 0) {
+            std::memcpy(core->elementAt(*c, base), data, i * cd.elementSize);
+            core->touchRange(*c, base, base + i);
+            core->markGroupsDirty(*c);
+        }
+    }
+    for (; i < count; ++i) core->attach(*c, entities[i], bytes + i * cd.elementSize);
+}
+
+void HostCore::gwAttachComponentFillById(void* api, uint32_t id, const Entity* entities, const void* value, size_t count) {
+    HostCore* core = host(api);
+    HostComponent* c = core->find(id);
+    if (!c) return;
+    core->reserve(*c, c->store->dense.size() + count);
+    for (size_t i = 0; i < count; ++i) core->attach(*c, entities[i], value);
+}
+
+void HostCore::gwRemoveComponent(void* api, Entity e, const std::string& name) {
+    if (HostComponent* c = host(api)->find(name)) host(api)->remove(*c, e);
+}
+
+void HostCore::gwRemoveComponentById(void* api, Entity e, uint32_t id) {
+    if (HostComponent* c = host(api)->find(id)) host(api)->remove(*c, e);
+}
+
+void HostCore::gwRemoveComponentsById(void* api, uint32_t id, const Entity* entities, size_t count) {
+    HostComponent* c = host(api)->find(id);
+    if (!c) return;
+    for (size_t i = 0; i < count; ++i) host(api)->remove(*c, entities[i]);
+}
+
+// Mutable lookups: the caller may write through the pointer, so stamp it.
+void* HostCore::gwGetComponent(void* api, Entity e, const std::string& name) {
+    HostComponent* c = host(api)->find(name);
+    return c ? gwGetComponentById(api, e, c->id) : nullptr;
+}
+
+void* HostCore::gwGetComponentById(void* api, Entity e, uint32_t id) {
+    HostComponent* c = host(api)->find(id);
+    if (!c) return nullptr;
+    const uint32_t index = host(api)->indexOf(*c, e);
+    if (index == kNone) return nullptr;
+    void* element = host(api)->requireElement(*c, index);
+    host(api)->touch(*c, index);
+    return element;
+}
+
+const void* HostCore::gwReadComponentById(void* api, Entity e, uint32_t id) {
+    HostComponent* c = host(api)->find(id);
+    if (!c) return nullptr;
+    const uint32_t index = host(api)->indexOf(*c, e);
+    return index != kNone ? host(api)->requireElement(*c, index) : nullptr;
+}
+
+void HostCore::gwMarkChangedById(void* api, Entity e, uint32_t id) {
+    HostComponent* c = host(api)->find(id);
+    if (!c) return;
+    const uint32_t index = host(api)->indexOf(*c, e);
+    if (index != kNone) host(api)->touch(*c, index);
+}
+
+bool HostCore::gwHasComponent(void* api, Entity e, const std::string& name) {
+    HostComponent* c = host(api)->find(name);
+    return c && host(api)->indexOf(*c, e) != kNone;
+}
+
+bool HostCore::gwHasComponentById(void* api, Entity e, uint32_t id) {
+    HostComponent* c = host(api)->find(id);
+    return c && host(api)->indexOf(*c, e) != kNone;
+}
+
+ComponentData* HostCore::gwGetComponentData(void* api, const std::string& name) {
+    HostComponent* c = host(api)->find(name);
+    return c ? c->store.get() : nullptr;
+}
+
+ComponentData* HostCore::gwGetComponentDataById(void* api, uint32_t id) {
+    HostComponent* c = host(api)->find(id);
+    return c ? c->store.get() : nullptr;
+}
+
+// --- Gateway: groups ---
+
+void HostCore::gwRegisterGroup(void* api, const std::vector<std::string>& names) {
+    std::vector<uint32_t> ids;
+    for (const std::string& name : names) ids.push_back(hashName(name));
+    host(api)->groupFor(ids.data(), ids.size());
+}
+
+void HostCore::gwRegisterGroupById(void* api, const uint32_t* ids, size_t count) {
+    host(api)->groupFor(ids, count);
+}
+
+void HostCore::gwUpdateParallelGroup(void* api, const std::vector<std::string>& names,
+                                     void (*func)(size_t, size_t, void*), void* user, size_t chunkSize) {
+    std::vector<uint32_t> ids;
+    for (const std::string& name : names) ids.push_back(hashName(name));
+    gwUpdateParallelGroupById(api, ids.data(), ids.size(), func, user, chunkSize);
+}
+
+void HostCore::gwUpdateParallelGroupById(void* api, const uint32_t* ids, size_t count,
+                                         void (*func)(size_t, size_t, void*), void* user, size_t chunkSize) {
+    HostCore* core = host(api);
+    HostGroup& group = core->groupFor(ids, count);
+    core->pack(group);
+    for (uint32_t member : group.ids) core->touchRange(*core->find(member), 0, group.size);
+    core->parallelFor(group.size, chunkSize, [=](size_t start, size_t end) { func(start, end, user); });
+}
+
+// --- Gateway: systems & iteration ---
+
+void HostCore::gwRegisterSystem(void* api, const std::string& name, void (*func)(float, void*), void* user) {
+    host(api)->m_scheduler.registerSystem(name, func, user);
+}
+
+void HostCore::gwRegisterSystemInLoop(void* api, SystemDesc& desc) {
+    host(api)->m_scheduler.registerSystemInLoop(desc);
+}
+
+void HostCore::gwRegisterSystemAccess(void* api, const char* name, const SystemAccess* access) {
+    host(api)->m_scheduler.setAccess(name, *access);
+}
+
+size_t HostCore::gwWorkerCount(void* api) {
+    return host(api)->m_pool.threadCount();
+}
+
+void HostCore::gwUpdateParallel(void* api, const std::string& name, void (*func)(Entity, void*, void*), void* user,
+                                size_t chunkSize) {
+    HostCore* core = host(api);
+    HostComponent* c = core->find(name);
+    if (!c) return;
+    const size_t elementSize = c->store->elementSize;
+    core->touchRange(*c, 0, c->store->dense.size());
+    core->parallelFor(c->store->dense.size(), chunkSize, [&](size_t start, size_t end) {
+        core->withRows(*c, start, end - start, true, [&](const Entity* entities, unsigned char* rows) {
+            for (size_t i = 0; i < end - start; ++i) func(entities[i], rows + i * elementSize, user);
+        });
+    });
+}
+
+void HostCore::gwUpdateParallelChunks(void* api, const std::string& name,
+                                      void (*func)(const Entity*, void*, size_t, void*), void* user, size_t chunkSize) {
+    if (HostComponent* c = host(api)->find(name)) host(api)->chunks(*c, func, user, chunkSize);
+}
+
+void HostCore::gwUpdateParallelChunksById(void* api, uint32_t id, void (*func)(const Entity*, void*, size_t, void*),
+                                          void* user, size_t chunkSize) {
+    if (HostComponent* c = host(api)->find(id)) host(api)->chunks(*c, func, user, chunkSize);
+}
+
+void HostCore::gwUpdateParallelColumnsById(void* api, uint32_t id,
+                                           void (*func)(const Entity*, void* const*, size_t, void*), void* user,
+                                           size_t chunkSize) {
+    HostCore* core = host(api);
+    HostComponent* c = core->find(id);
+    if (!c) return;
+    if (!c->soa) throw std::logic_error("HostCore: '" + c->name + "' is not stored as columns");
+    const auto* entities = reinterpret_cast<const Entity*>(c->store->dense.data());
+    if (chunkSize < SIZE_MAX - 7) chunkSize = (chunkSize + 7) & ~size_t(7);
+    core->touchRange(*c, 0, c->store->dense.size());
+    core->parallelFor(c->store->dense.size(), chunkSize, [&](size_t start, size_t end) {
+        std::array<void*, kMaxColumns> columns;
+        for (size_t f = 0; f < c->fields.size(); ++f) columns[f] = c->columns[f].get() + start * c->fields[f].size;
+        func(entities + start, columns.data(), end - start, user);
+    });
+}
+
+void HostCore::gwUpdateParallelChangedById(void* api, uint32_t id, uint64_t* cursor,
+                                           void (*func)(const Entity*, void*, size_t, void*), void* user,
+                                           size_t chunkSize) {
+    HostCore* core = host(api);
+    HostComponent* c = core->find(id);
+    if (!c || !cursor) return;
+
+    // Writes from here on carry a newer tick than the one the cursor keeps.
+    const uint64_t since = *cursor;
+    *cursor = core->m_changeTick.fetch_add(1, std::memory_order_relaxed);
+
+    // Merge consecutive changed blocks into runs of at most chunkSize (or
+    // one block, if that is larger). One range buffer per nesting level, as
+    // in withRows: func may start another changed pass on this thread.
+    thread_local std::deque<std::vector<std::pair<size_t, size_t>>> buffers;
+    thread_local size_t depth = 0;
+    if (buffers.size() == depth) buffers.emplace_back();
+    std::vector<std::pair<size_t, size_t>>& ranges = buffers[depth];
+    ranges.clear();
+    ComponentData& cd = *c->store;
+    const size_t count = cd.dense.size();
+    for (size_t start = 0; start < count; start += kChangeBlock) {
+        if (std::atomic_ref<uint64_t>(c->versions[start / kChangeBlock]).load(std::memory_order_relaxed) <= since) continue;
+        const size_t end = std::min(count, start + kChangeBlock);
+        if (!ranges.empty() && ranges.back().second == start &&
+            (chunkSize == 0 || end - ranges.back().first <= chunkSize)) {
+            ranges.back().second = end;
+        } else {
+            ranges.emplace_back(start, end);
+        }
+    }
+
+    struct Level {
+        size_t& depth;
+        explicit Level(size_t& d) : depth(d) { ++depth; }
+        ~Level() { --depth; }
+    } level(depth);
+    core->parallelFor(ranges.size(), 1, [&](size_t first, size_t last) {
+        for (size_t r = first; r < last; ++r) {
+            const auto [start, end] = ranges[r];
+            core->withRows(*c, start, end - start, false, [&](const Entity* entities, unsigned char* rows) {
+                func(entities, rows, end - start, user);
+            });
+        }
+    });
+}
+
+void HostCore::gwReadParallelChunksById(void* api, uint32_t id,
+                                        void (*func)(const Entity*, const void*, size_t, void*), void* user,
+                                        size_t chunkSize) {
+    HostCore* core = host(api);
+    HostComponent* c = core->find(id);
+    if (!c) return;
+    core->parallelFor(c->store->dense.size(), chunkSize, [&](size_t start, size_t end) {
+        core->withRows(*c, start, end - start, false, [&](const Entity* entities, const unsigned char* rows) {
+            func(entities, rows, end - start, user);
+        });
+    });
+}
+
+void HostCore::gwUpdateParallelRangeById(void* api, uint32_t id, size_t begin, size_t end,
+                                         void (*func)(const Entity*, void*, size_t, void*), void* user,
+                                         size_t chunkSize) {
+    HostCore* core = host(api);
+    HostComponent* c = core->find(id);
+    if (!c) return;
+    end = std::min(end, c->store->dense.size());
+    if (begin >= end) return;
+    core->touchRange(*c, begin, end);
+    core->parallelFor(end - begin, chunkSize, [&](size_t start, size_t stop) {
+        core->withRows(*c, begin + start, stop - start, true, [&](const Entity* entities, unsigned char* rows) {
+            func(entities, rows, stop - start, user);
+        });
+    });
+}
+
+// --- Gateway: events ---
+
+uint32_t HostCore::gwRegisterEvent(void* api, const std::string& name) {
+    const uint32_t id = hashName(name);
+    host(api)->m_eventNames.emplace(id, name);
+    return id;
+}
+
+bool HostCore::gwRegisterEventById(void* api, uint32_t id, const char* name) {
+    auto [it, inserted] = host(api)->m_eventNames.emplace(id, name);
+    return inserted || it->second == name;
+}
+
+void HostCore::gwPushEvent(void* api, uint32_t id, void* data, size_t size) {
+    HostCore* core = host(api);
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    std::lock_guard<std::mutex> lock(core->m_eventMutex);
+    core->m_eventQueue.push_back(QueuedEvent{ id, std::vector<unsigned char>(bytes, bytes + size) });
+}
+
+void HostCore::gwEmitEvent(void* api, uint32_t id, void* data, size_t size) {
+    host(api)->dispatch(id, data, size);
+}
+
+void HostCore::gwSubscribe(void* api, uint32_t id, void (*func)(uint32_t, const EventData&, void*), void* user) {
+    host(api)->m_subscribers[id].push_back(Subscriber{ func, user });
+}
@@ -0,0 +1,427 @@
+#pragma once
+#include "headers/FractalCORE_gateway.h"
+#include "headers/FractalCORE_jobs.h"
+#include "headers/FractalCORE_scheduler.h"
+#include "headers/Structs&Classes.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Engine clock handed out through getEngineClock.
+ * The module headers only forward-declare it; the host owns the definition.
+ */
+class Clock {
+public:
+    Clock() : m_start(std::chrono::steady_clock::now()) {}
+
+    double elapsedSeconds() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+    }
+    uint64_t frame() const { return m_frame; }
+    void advanceFrame() { ++m_frame; }
+
+private:
+    std::chrono::steady_clock::time_point m_start;
+    uint64_t m_frame = 0;
+};
+
+// Entity index -> dense index table, allocated in pages so a core can hand
+// back the memory of index ranges that no longer hold any component.
+class SparsePages {
+public:
+    static constexpr uint32_t kNone = UINT32_MAX;
+    static constexpr size_t kPageSize = 4096;
+
+    uint32_t get(uint32_t index) const {
+        const size_t page = index / kPageSize;
+        if (page >= m_pages.size() || !m_pages[page].slots) return kNone;
+        return m_pages[page].slots[index % kPageSize];
+    }
+
+    void set(uint32_t index, uint32_t value) {
+        const size_t page = index / kPageSize;
+        if (page >= m_pages.size()) {
+            if (value == kNone) return;
+            m_pages.resize(page + 1);
+        }
+        Page& p = m_pages[page];
+        if (!p.slots) {
+            if (value == kNone) return;
+            p.slots = std::make_unique<uint32_t[]>(kPageSize);
+            std::fill_n(p.slots.get(), kPageSize, kNone);
+        }
+        uint32_t& slot = p.slots[index % kPageSize];
+        if (slot == kNone && value != kNone) ++p.used;
+        if (slot != kNone && value == kNone) --p.used;
+        slot = value;
+    }
+
+    // Frees pages with no live entries; returns how many were released.
+    size_t compact() {
+        size_t freed = 0;
+        for (Page& p : m_pages) {
+            if (p.slots && p.used == 0) {
+                p.slots.reset();
+                ++freed;
+            }
+        }
+        while (!m_pages.empty() && !m_pages.back().slots) m_pages.pop_back();
+        m_pages.shrink_to_fit();
+        return freed;
+    }
+
+    // Raw page access for snapshots: null when the page is not allocated.
+    size_t pageCount() const { return m_pages.size(); }
+    const uint32_t* pageSlots(size_t page) const { return m_pages[page].slots.get(); }
+    uint32_t pageUsed(size_t page) const { return m_pages[page].used; }
+
+    void clear() { m_pages.clear(); }
+
+    void restorePage(size_t page, const uint32_t* slots, uint32_t used) {
+        if (page >= m_pages.size()) m_pages.resize(page + 1);
+        Page& p = m_pages[page];
+        if (!p.slots) p.slots = std::make_unique<uint32_t[]>(kPageSize);
+        std::copy_n(slots, kPageSize, p.slots.get());
+        p.used = used;
+    }
+
+    size_t allocatedPages() const {
+        size_t count = 0;
+        for (const Page& p : m_pages) count += p.slots ? 1 : 0;
+        return count;
+    }
+
+private:
+    struct Page {
+        std::unique_ptr<uint32_t[]> slots;
+        uint32_t used = 0;
+    };
+    std::vector<Page> m_pages;
+};
+
+/**
+ * @brief Free entity slots as runs of consecutive indices that share a
+ * generation, i.e. blocks that can be handed out as consecutive IDs.
+ * Runs are merged on insertion and split when a slot inside one is taken.
+ */
+class FreeRuns {
+public:
+    void add(uint32_t index, uint32_t generation) {
+        uint32_t start = index;
+        uint32_t length = 1;
+        auto next = m_byStart.find(index + 1);
+        if (next != m_byStart.end() && next->second.generation == generation) {
+            length += next->second.length;
+            erase(next);
+        }
+        auto it = m_byStart.lower_bound(index);
+        if (it != m_byStart.begin()) {
+            auto prev = std::prev(it);
+            if (prev->first + prev->second.length == index && prev->second.generation == generation) {
+                start = prev->first;
+                length += prev->second.length;
+                erase(prev);
+            }
+        }
+        insert(start, length, generation);
+    }
+
+    // Takes `count` consecutive slots from the smallest run that holds them.
+    bool take(size_t count, uint32_t& first, uint32_t& generation) {
+        auto fit = m_bySize.lower_bound({ count, 0 });
+        if (fit == m_bySize.end()) return false;
+        auto it = m_byStart.find(fit->second);
+        first = it->first;
+        generation = it->second.generation;
+        const Run run = it->second;
+        erase(it);
+        if (run.length > count) insert(first + static_cast<uint32_t>(count), run.length - static_cast<uint32_t>(count), generation);
+        return true;
+    }
+
+    // Drops one free slot, splitting the run around it.
+    void remove(uint32_t index) {
+        auto it = m_byStart.upper_bound(index);
+        if (it == m_byStart.begin()) return;
+        --it;
+        const uint32_t start = it->first;
+        const Run run = it->second;
+        if (index >= start + run.length) return;
+        erase(it);
+        if (index > start) insert(start, index - start, run.generation);
+        if (index + 1 < start + run.length) insert(index + 1, start + run.length - index - 1, run.generation);
+    }
+
+    void clear() {
+        m_byStart.clear();
+        m_bySize.clear();
+    }
+
+    size_t runCount() const { return m_byStart.size(); }
+
+private:
+    struct Run {
+        uint32_t length;
+        uint32_t generation;
+    };
+
+    void insert(uint32_t start, uint32_t length, uint32_t generation) {
+        m_byStart.emplace(start, Run{ length, generation });
+        m_bySize.emplace(length, start);
+    }
+    void erase(std::map<uint32_t, Run>::iterator it) {
+        m_bySize.erase({ it->second.length, it->first });
+        m_byStart.erase(it);
+    }
+
+    std::map<uint32_t, Run> m_byStart;
+    std::set<std::pair<size_t, uint32_t>> m_bySize; // (length, start)
+};
+
+/**
+ * @brief Headless reference implementation of every FractalCORE_Gateway entry.
+ *
+ * Components live in sparse sets (ComponentData: dense entity IDs and packed
+ * element bytes; HostComponent: the paged index-to-dense table); SoA components keep one
+ * 32-byte aligned column per field instead of the packed bytes, and row-based
+ * passes over them work on per-chunk copies in struct layout. Parallel
+ * passes, tasks and the system DAG all run on one WorkStealingPool.
+ * Each component keeps a change tick per block of 64 dense slots for
+ * updateParallelChangedById.
+ * Not thread-safe for structural changes: attach/remove/create must not
+ * race with each other or with iteration, same as the real core.
+ */
+class HostCore {
+public:
+    explicit HostCore(size_t threads = std::thread::hardware_concurrency());
+    ~HostCore();
+
+    HostCore(const HostCore&) = delete;
+    HostCore& operator=(const HostCore&) = delete;
+
+    FractalCORE_Gateway* gateway() { return &m_gateway; }
+    WorkStealingPool& pool() { return m_pool; }
+
+    /**
+     * @brief Runs one frame: main-thread tasks, due interval tasks, the system
+     * DAG, then the events queued with pushEvent.
+     */
+    void runFrame(float dt);
+    bool running() const { return m_running; }
+    size_t entityCount() const { return m_liveEntities; }
+    // Entity slots ever allocated, live or free.
+    size_t slotCount() const { return m_slots.size(); }
+    size_t sparsePageCount() const;
+
+    /**
+     * @brief Runs compactStorage every `frames` frames (0 disables it).
+     */
+    void setCompactionInterval(uint64_t frames) { m_compactionInterval = frames; }
+
+private:
+    static constexpr uint32_t kNone = UINT32_MAX;
+    static constexpr size_t kChangeBlock = 64;
+    // Fields per SoA component; column passes build each chunk's column
+    // pointers on the stack.
+    static constexpr size_t kMaxColumns = 64;
+
+    struct AlignedFree {
+        void operator()(unsigned char* p) const;
+    };
+    using Column = std::unique_ptr<unsigned char[], AlignedFree>;
+
+    // Snapshot file whose element sections back restored components.
+    struct MappedFile;
+
+    struct HostComponent {
+        std::string name;
+        uint32_t id = 0;
+        std::unique_ptr<ComponentData> store;
+        SparsePages sparse;
+        bool soa = false;
+        std::vector<FieldDesc> fields;
+        std::vector<Column> columns;
+        size_t columnCapacity = 0;
+        std::vector<size_t> groups;
+        std::vector<uint64_t> versions; // change tick per kChangeBlock dense slots
+        std::shared_ptr<MappedFile> mapping; // set while data points into a snapshot
+    };
+
+    // Written to snapshots as-is, so no padding.
+    struct EntitySlot {
+        uint32_t generation;
+        uint32_t alive;
+    };
+
+    struct HostGroup {
+        std::vector<uint32_t> ids;
+        size_t size = 0;
+        bool dirty = true;
+    };
+
+    struct Subscriber {
+        void (*func)(uint32_t, const EventData&, void*);
+        void* userData;
+    };
+
+    struct QueuedEvent {
+        uint32_t id;
+        std::vector<unsigned char> bytes;
+    };
+
+    // --- Storage ---
+    HostComponent* find(uint32_t id);
+    HostComponent* find(const std::string& name);
+    bool addComponent(uint32_t id, const char* name, size_t elementSize, size_t capacity,
+                      const FieldDesc* fields, size_t fieldCount);
+    void reserve(HostComponent& c, size_t count);
+    void* elementAt(HostComponent& c, size_t index);
+    void* requireElement(HostComponent& c, size_t index);
+    void writeElement(HostComponent& c, size_t index, const void* bytes);
+    void moveElement(HostComponent& c, size_t from, size_t to);
+    void swapElements(HostComponent& c, size_t a, size_t b);
+    uint32_t indexOf(const HostComponent& c, Entity e) const;
+    void attach(HostComponent& c, Entity e, const void* bytes);
+    void remove(HostComponent& c, Entity e);
+    void markGroupsDirty(HostComponent& c);
+    void touch(HostComponent& c, size_t index);
+    void touchRange(HostComponent& c, size_t start, size_t end);
+    bool isAlive(Entity e) const;
+    size_t compact();
+
+    // --- Entity slots ---
+    void freeSlot(uint32_t index);
+    void pruneFreeSlots();
+    void rebuildFreeSlots();
+
+    // --- Groups ---
+    HostGroup& groupFor(const uint32_t* ids, size_t count);
+    void pack(HostGroup& group);
+
+    // --- Iteration ---
+    // Body is taken by reference rather than as std::function so an inline
+    // (single-chunk or single-thread) pass does not allocate.
+    template<typename Body>
+    void parallelFor(size_t count, size_t chunkSize, const Body& body);
+    // Runs body(entities, rows) over dense elements [start, start + count) as
+    // packed structs. SoA components are gathered into a per-thread buffer
+    // first and, with writeBack, scattered into their columns afterwards.
+    template<typename Body>
+    void withRows(HostComponent& c, size_t start, size_t count, bool writeBack, const Body& body);
+    void chunks(HostComponent& c, void (*func)(const Entity*, void*, size_t, void*), void* user, size_t chunkSize);
+    void dispatch(uint32_t id, const void* data, size_t size);
+
+    // --- Gateway entry points ---
+    static void gwStop(void*);
+    static float gwGetDeltaTime(void*);
+    static Clock& gwGetEngineClock(void*);
+    static void gwEnqueueTask(void*, const Task&);
+    static void gwRegisterIntervalTask(void*, const TickTask&);
+    static Entity gwCreateEntity(void*);
+    static void gwRegisterComponent(void*, const std::string&, size_t, size_t);
+    static void gwAttachComponent(void*, Entity, const std::string&, void*);
+    static void gwRemoveComponent(void*, Entity, const std::string&);
+    static void* gwGetComponent(void*, Entity, const std::string&);
+    static bool gwHasComponent(void*, Entity, const std::string&);
+    static ComponentData* gwGetComponentData(void*, const std::string&);
+    static void gwRegisterGroup(void*, const std::vector<std::string>&);
+    static void gwRegisterSystem(void*, const std::string&, void (*)(float, void*), void*);
+    static void gwRegisterSystemInLoop(void*, SystemDesc&);
+    static void gwRegisterSystemAccess(void*, const char*, const SystemAccess*);
+    static size_t gwWorkerCount(void*);
+    static void gwUpdateParallel(void*, const std::string&, void (*)(Entity, void*, void*), void*, size_t);
+    static void gwUpdateParallelGroup(void*, const std::vector<std::string>&, void (*)(size_t, size_t, void*),
+                                      void*, size_t);
+    static uint32_t gwRegisterEvent(void*, const std::string&);
+    static void gwPushEvent(void*, uint32_t, void*, size_t);
+    static void gwEmitEvent(void*, uint32_t, void*, size_t);
+    static void gwSubscribe(void*, uint32_t, void (*)(uint32_t, const EventData&, void*), void*);
+    static void gwUpdateParallelChunks(void*, const std::string&, void (*)(const Entity*, void*, size_t, void*),
+                                       void*, size_t);
+    static bool gwRegisterComponentById(void*, uint32_t, const char*, size_t, size_t);
+    static void gwAttachComponentById(void*, Entity, uint32_t, void*);
+    static void gwRemoveComponentById(void*, Entity, uint32_t);
+    static void* gwGetComponentById(void*, Entity, uint32_t);
+    static bool gwHasComponentById(void*, Entity, uint32_t);
+    static ComponentData* gwGetComponentDataById(void*, uint32_t);
+    static void gwUpdateParallelChunksById(void*, uint32_t, void (*)(const Entity*, void*, size_t, void*),
+                                           void*, size_t);
+    static bool gwRegisterEventById(void*, uint32_t, const char*);
+    static Entity gwCreateEntities(void*, size_t);
+    static void gwAttachComponentsById(void*, uint32_t, const Entity*, const void*, size_t);
+    static void gwAttachComponentFillById(void*, uint32_t, const Entity*, const void*, size_t);
+    static void gwRemoveComponentsById(void*, uint32_t, const Entity*, size_t);
+    static bool gwRegisterComponentSoAById(void*, uint32_t, const char*, size_t, const FieldDesc*, size_t, size_t);
+    static void gwUpdateParallelColumnsById(void*, uint32_t, void (*)(const Entity*, void* const*, size_t, void*),
+                                            void*, size_t);
+    static void gwRegisterGroupById(void*, const uint32_t*, size_t);
+    static void gwUpdateParallelGroupById(void*, const uint32_t*, size_t, void (*)(size_t, size_t, void*),
+                                          void*, size_t);
+    static void gwDestroyEntity(void*, Entity);
+    static void gwDestroyEntities(void*, const Entity*, size_t);
+    static bool gwIsAlive(void*, Entity);
+    static size_t gwCompactStorage(void*);
+    static void gwUpdateParallelChangedById(void*, uint32_t, uint64_t*, void (*)(const Entity*, void*, size_t, void*),
+                                            void*, size_t);
+    static void gwMarkChangedById(void*, Entity, uint32_t);
+    static const void* gwReadComponentById(void*, Entity, uint32_t);
+    static void gwReadParallelChunksById(void*, uint32_t, void (*)(const Entity*, const void*, size_t, void*),
+                                         void*, size_t);
+    static void gwSubmitTask(void*, InlineTask*, WaitGroup*);
+    static void gwContinueWith(void*, WaitGroup*, InlineTask*, WaitGroup*);
+    static void gwWaitGroup(void*, WaitGroup*);
+    static uint64_t gwScheduleTickTask(void*, InlineTask*, const TickTaskDesc*);
+    static bool gwCancelTickTask(void*, uint64_t);
+    static void gwUpdateParallelRangeById(void*, uint32_t, size_t, size_t,
+                                          void (*)(const Entity*, void*, size_t, void*), void*, size_t);
+    // Defined in HostSnapshot.cpp.
+    static bool gwSaveSnapshot(void*, const char*, const SnapshotLayout*, size_t);
+    static bool gwLoadSnapshot(void*, const char*, const SnapshotLayout*, size_t);
+
+    FractalCORE_Gateway m_gateway{};
+    // Declared before the pool so background timer runs drain before the
+    // timers they refer to are freed.
+    TimerWheel m_timers;
+    WorkStealingPool m_pool;
+    SystemScheduler m_scheduler;
+    Clock m_clock;
+    float m_dt = 0.0f;
+    bool m_running = true;
+    uint64_t m_compactionInterval = 600;
+
+    std::vector<EntitySlot> m_slots;
+    // Free slots, oldest first, for single creations. Slots that bulk
+    // creation took out of m_freeRuns stay queued until popped or pruned;
+    // m_freeStale counts them.
+    std::deque<uint32_t> m_freeSlots;
+    size_t m_freeStale = 0;
+    FreeRuns m_freeRuns;
+    size_t m_liveEntities = 0;
+    std::atomic<uint64_t> m_changeTick{ 1 };
+
+    std::unordered_map<uint32_t, std::unique_ptr<HostComponent>> m_components;
+    std::unordered_map<std::string, uint32_t> m_componentIds;
+    std::vector<HostGroup> m_groups;
+
+    std::unordered_map<uint32_t, std::string> m_eventNames;
+    std::unordered_map<uint32_t, std::vector<Subscriber>> m_subscribers;
+    std::mutex m_eventMutex;
+    std::vector<QueuedEvent> m_eventQueue;
+
+    std::mutex m_taskMutex;
+    std::vector<std::function<void()>> m_mainTasks;
+};
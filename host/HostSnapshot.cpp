@@ -0,0 +1,413 @@
+// Snapshot save/restore for HostCore.
+//
+// File layout (native endianness, every section starts on a page boundary):
+//   header | component table | entity slots | free list |
+//   per component: dense IDs, elements (or SoA columns back to back),
+//                  sparse page table followed by the allocated pages.
+// Restore maps the whole file copy-on-write and points each component's
+// element array straight at its section; dense IDs and sparse pages are
+// copied in bulk. Before any of that, every section is checked against the
+// header and the allocator, so a truncated or corrupt file is refused
+// without touching the world.
+
+#include "HostCore.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <type_traits>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr char kMagic[8] = { 'F', 'R', 'S', 'N', 'A', 'P', '\0', '\0' };
+constexpr uint32_t kFormatVersion = 1;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t pageSize;
+    uint64_t componentCount;
+    uint64_t slotCount;
+    uint64_t slotsOffset;
+    uint64_t freeCount;
+    uint64_t freeOffset;
+    uint64_t liveEntities;
+};
+
+struct FileComponent {
+    uint32_t id;
+    uint32_t soa;
+    uint64_t elementSize;
+    uint64_t layoutHash;
+    uint64_t count;        // dense size
+    uint64_t denseOffset;
+    uint64_t dataOffset;
+    uint64_t dataBytes;
+    uint64_t sparsePages;  // entries in the page table
+    uint64_t sparseOffset; // page table, then the allocated pages in order
+};
+
+struct SparsePageEntry {
+    uint32_t present;
+    uint32_t used;
+};
+
+size_t systemPageSize() {
+#ifdef _WIN32
+    return 4096;
+#else
+    const long size = sysconf(_SC_PAGESIZE);
+    return size > 0 ? static_cast<size_t>(size) : 4096;
+#endif
+}
+
+uint64_t alignUp(uint64_t value, uint64_t align) {
+    return (value + align - 1) / align * align;
+}
+
+// Sequential writer that places each section at a page-aligned offset.
+class SectionWriter {
+public:
+    SectionWriter(std::FILE* file, uint64_t pageSize, uint64_t start) : m_file(file), m_pageSize(pageSize), m_end(start) {}
+
+    uint64_t reserve(uint64_t bytes) {
+        const uint64_t offset = alignUp(m_end, m_pageSize);
+        m_end = offset + bytes;
+        return offset;
+    }
+
+    bool write(uint64_t offset, const void* data, uint64_t bytes) {
+        if (bytes == 0) return true;
+#ifdef _WIN32
+        const bool positioned = _fseeki64(m_file, static_cast<long long>(offset), SEEK_SET) == 0;
+#else
+        const bool positioned = fseeko(m_file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+        return positioned && std::fwrite(data, 1, bytes, m_file) == bytes;
+    }
+
+private:
+    std::FILE* m_file;
+    uint64_t m_pageSize;
+    uint64_t m_end;
+};
+
+} // namespace
+
+struct HostCore::MappedFile {
+    unsigned char* base = nullptr;
+    size_t size = 0;
+
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+#ifdef _WIN32
+        delete[] base;
+#else
+        if (base) munmap(base, size);
+#endif
+    }
+
+    // Private (copy-on-write) mapping: restored components can be written
+    // without touching the file. Windows reads the file into memory instead.
+    bool open(const char* path) {
+#ifdef _WIN32
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) return false;
+        size = static_cast<size_t>(in.tellg());
+        base = new unsigned char[size];
+        in.seekg(0);
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(base), static_cast<std::streamsize>(size)));
+#else
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st {};
+        if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+        size = static_cast<size_t>(st.st_size);
+        void* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) return false;
+        base = static_cast<unsigned char*>(mapped);
+        return true;
+#endif
+    }
+
+    // Empty sections may be reserved past the last byte written.
+    bool contains(uint64_t offset, uint64_t bytes) const {
+        return bytes == 0 || (offset <= size && bytes <= size - offset);
+    }
+
+    // `count` elements of `elementBytes` each at `offset`, without
+    // overflowing on corrupt counts.
+    bool containsArray(uint64_t offset, uint64_t count, uint64_t elementBytes) const {
+        return count == 0 || (offset <= size && elementBytes != 0 && count <= (size - offset) / elementBytes);
+    }
+};
+
+bool HostCore::gwSaveSnapshot(void* api, const char* path, const SnapshotLayout* layouts, size_t count) {
+    static_assert(std::is_trivially_copyable_v<EntitySlot> && sizeof(EntitySlot) == 8);
+    HostCore* core = static_cast<HostCore*>(api);
+
+    std::vector<HostComponent*> components;
+    for (size_t i = 0; i < count; ++i) {
+        HostComponent* c = core->find(layouts[i].id);
+        if (!c || c->store->elementSize != layouts[i].elementSize) return false;
+        components.push_back(c);
+    }
+
+    const std::string tmpPath = std::string(path) + ".tmp";
+    std::FILE* file = std::fopen(tmpPath.c_str(), "wb");
+    if (!file) return false;
+
+    const uint64_t pageSize = systemPageSize();
+    const uint64_t tableBytes = sizeof(FileHeader) + components.size() * sizeof(FileComponent);
+    SectionWriter out(file, pageSize, tableBytes);
+    bool ok = true;
+
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kFormatVersion;
+    header.pageSize = static_cast<uint32_t>(pageSize);
+    header.componentCount = components.size();
+    header.slotCount = core->m_slots.size();
+    header.slotsOffset = out.reserve(core->m_slots.size() * sizeof(EntitySlot));
+    ok = ok && out.write(header.slotsOffset, core->m_slots.data(), core->m_slots.size() * sizeof(EntitySlot));
+
+    core->pruneFreeSlots();
+    const std::vector<uint32_t> freeSlots(core->m_freeSlots.begin(), core->m_freeSlots.end());
+    header.freeCount = freeSlots.size();
+    header.freeOffset = out.reserve(freeSlots.size() * sizeof(uint32_t));
+    ok = ok && out.write(header.freeOffset, freeSlots.data(), freeSlots.size() * sizeof(uint32_t));
+    header.liveEntities = core->m_liveEntities;
+
+    std::vector<FileComponent> table;
+    for (size_t i = 0; i < components.size() && ok; ++i) {
+        HostComponent& c = *components[i];
+        ComponentData& cd = *c.store;
+        FileComponent entry{};
+        entry.id = c.id;
+        entry.soa = c.soa ? 1 : 0;
+        entry.elementSize = cd.elementSize;
+        entry.layoutHash = layouts[i].layoutHash;
+        entry.count = cd.dense.size();
+
+        entry.denseOffset = out.reserve(entry.count * sizeof(uint32_t));
+        ok = ok && out.write(entry.denseOffset, cd.dense.data(), entry.count * sizeof(uint32_t));
+
+        if (c.soa) {
+            for (const FieldDesc& field : c.fields) entry.dataBytes += field.size * entry.count;
+            entry.dataOffset = out.reserve(entry.dataBytes);
+            uint64_t offset = entry.dataOffset;
+            for (size_t f = 0; f < c.fields.size() && ok; ++f) {
+                ok = out.write(offset, c.columns[f].get(), c.fields[f].size * entry.count);
+                offset += c.fields[f].size * entry.count;
+            }
+        } else {
+            entry.dataBytes = entry.count * cd.elementSize;
+            entry.dataOffset = out.reserve(entry.dataBytes);
+            ok = ok && out.write(entry.dataOffset, cd.data, entry.dataBytes);
+        }
+
+        std::vector<SparsePageEntry> pages(c.sparse.pageCount());
+        size_t present = 0;
+        for (size_t p = 0; p < pages.size(); ++p) {
+            pages[p] = SparsePageEntry{ c.sparse.pageSlots(p) ? 1u : 0u, c.sparse.pageUsed(p) };
+            present += pages[p].present;
+        }
+        entry.sparsePages = pages.size();
+        const uint64_t pageBytes = SparsePages::kPageSize * sizeof(uint32_t);
+        entry.sparseOffset = out.reserve(pages.size() * sizeof(SparsePageEntry) + present * pageBytes);
+        ok = ok && out.write(entry.sparseOffset, pages.data(), pages.size() * sizeof(SparsePageEntry));
+        uint64_t offset = entry.sparseOffset + pages.size() * sizeof(SparsePageEntry);
+        for (size_t p = 0; p < pages.size() && ok; ++p) {
+            if (!pages[p].present) continue;
+            ok = out.write(offset, c.sparse.pageSlots(p), pageBytes);
+            offset += pageBytes;
+        }
+        table.push_back(entry);
+    }
+
+    ok = ok && out.write(0, &header, sizeof(header));
+    ok = ok && out.write(sizeof(header), table.data(), table.size() * sizeof(FileComponent));
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+
+    // Replace the previous snapshot only once the new one is complete.
+    std::error_code error;
+    std::filesystem::rename(tmpPath, path, error);
+    return !error;
+}
+
+bool HostCore::gwLoadSnapshot(void* api, const char* path, const SnapshotLayout* layouts, size_t count) {
+    HostCore* core = static_cast<HostCore*>(api);
+    auto file = std::make_shared<MappedFile>();
+    if (!file->open(path) || !file->contains(0, sizeof(FileHeader))) return false;
+
+    // Validate everything before touching any state; a truncated or corrupt
+    // file is refused like a missing one.
+    FileHeader header;
+    std::memcpy(&header, file->base, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kFormatVersion) return false;
+    // Element sections are used in place, so they must keep the alignment
+    // they were written with.
+    const uint64_t pageSize = header.pageSize;
+    if (pageSize < alignof(std::max_align_t) || (pageSize & (pageSize - 1)) != 0) return false;
+    auto aligned = [&](uint64_t offset) { return offset % pageSize == 0; };
+    if (!file->containsArray(sizeof(header), header.componentCount, sizeof(FileComponent)) ||
+        header.slotCount > Entity::kIndexMask ||
+        !aligned(header.slotsOffset) || !file->containsArray(header.slotsOffset, header.slotCount, sizeof(EntitySlot)) ||
+        !aligned(header.freeOffset) || !file->containsArray(header.freeOffset, header.freeCount, sizeof(uint32_t))) {
+        return false;
+    }
+    const auto* table = reinterpret_cast<const FileComponent*>(file->base + sizeof(header));
+    const auto* slots = reinterpret_cast<const EntitySlot*>(file->base + header.slotsOffset);
+    const auto* freeSlots = reinterpret_cast<const uint32_t*>(file->base + header.freeOffset);
+
+    // The allocator: live count matches the alive slots, and the free list
+    // names every other slot exactly once.
+    uint64_t alive = 0;
+    for (uint64_t i = 0; i < header.slotCount; ++i) {
+        if (slots[i].alive > 1 || slots[i].generation > Entity::kMaxGeneration) return false;
+        alive += slots[i].alive;
+    }
+    if (alive != header.liveEntities || header.freeCount != header.slotCount - alive) return false;
+    std::vector<bool> listed(header.slotCount);
+    for (uint64_t i = 0; i < header.freeCount; ++i) {
+        const uint32_t index = freeSlots[i];
+        if (index >= header.slotCount || slots[index].alive || listed[index]) return false;
+        listed[index] = true;
+    }
+
+    // Components not in the snapshot would keep IDs of the replaced world.
+    for (const auto& [id, c] : core->m_components) {
+        if (c->store->dense.empty()) continue;
+        if (std::none_of(layouts, layouts + count, [&](const SnapshotLayout& layout) { return layout.id == id; })) {
+            return false;
+        }
+    }
+
+    constexpr uint64_t kPageBytes = SparsePages::kPageSize * sizeof(uint32_t);
+    const uint64_t maxPages = (header.slotCount + SparsePages::kPageSize - 1) / SparsePages::kPageSize;
+    std::vector<std::pair<HostComponent*, const FileComponent*>> restores;
+    for (size_t i = 0; i < count; ++i) {
+        const FileComponent* entry = nullptr;
+        for (uint64_t t = 0; t < header.componentCount; ++t) {
+            if (table[t].id == layouts[i].id) entry = &table[t];
+        }
+        HostComponent* c = core->find(layouts[i].id);
+        if (!entry || !c) return false;
+        if (entry->elementSize != layouts[i].elementSize || entry->layoutHash != layouts[i].layoutHash ||
+            entry->elementSize != c->store->elementSize || (entry->soa != 0) != c->soa) {
+            return false;
+        }
+
+        // Sections: in the file, aligned, and exactly the size the count implies.
+        if (entry->count > header.liveEntities || entry->sparsePages > maxPages ||
+            !aligned(entry->denseOffset) || !aligned(entry->dataOffset) || !aligned(entry->sparseOffset) ||
+            !file->containsArray(entry->denseOffset, entry->count, sizeof(uint32_t)) ||
+            !file->containsArray(entry->sparseOffset, entry->sparsePages, sizeof(SparsePageEntry))) {
+            return false;
+        }
+        uint64_t rowBytes = entry->elementSize;
+        if (c->soa) {
+            rowBytes = 0;
+            for (const FieldDesc& field : c->fields) rowBytes += field.size;
+        }
+        if (entry->dataBytes != entry->count * rowBytes || !file->contains(entry->dataOffset, entry->dataBytes)) return false;
+
+        const auto* pages = reinterpret_cast<const SparsePageEntry*>(file->base + entry->sparseOffset);
+        uint64_t present = 0;
+        for (uint64_t p = 0; p < entry->sparsePages; ++p) {
+            if (pages[p].present > 1 || (!pages[p].present && pages[p].used != 0)) return false;
+            present += pages[p].present;
+        }
+        const uint64_t pageDataOffset = entry->sparseOffset + entry->sparsePages * sizeof(SparsePageEntry);
+        if (!file->containsArray(pageDataOffset, present, kPageBytes)) return false;
+
+        // Dense IDs name live entities of the restored allocator...
+        const auto* dense = reinterpret_cast<const uint32_t*>(file->base + entry->denseOffset);
+        for (uint64_t d = 0; d < entry->count; ++d) {
+            const Entity e{ dense[d] };
+            if (e.index() >= header.slotCount || !slots[e.index()].alive || slots[e.index()].generation != e.generation()) {
+                return false;
+            }
+        }
+        // ...and the sparse pages map exactly those back to their position.
+        const auto* pageData = reinterpret_cast<const uint32_t*>(file->base + pageDataOffset);
+        uint64_t mapped = 0;
+        for (uint64_t p = 0; p < entry->sparsePages; ++p) {
+            if (!pages[p].present) continue;
+            uint32_t used = 0;
+            for (size_t j = 0; j < SparsePages::kPageSize; ++j) {
+                const uint32_t value = pageData[j];
+                if (value == SparsePages::kNone) continue;
+                if (value >= entry->count || Entity{ dense[value] }.index() != p * SparsePages::kPageSize + j) return false;
+                ++used;
+            }
+            if (used != pages[p].used) return false;
+            mapped += used;
+            pageData += SparsePages::kPageSize;
+        }
+        if (mapped != entry->count) return false;
+        restores.emplace_back(c, entry);
+    }
+
+    core->m_slots.assign(slots, slots + header.slotCount);
+    core->m_freeSlots.assign(freeSlots, freeSlots + header.freeCount);
+    core->m_liveEntities = header.liveEntities;
+    core->rebuildFreeSlots();
+
+    for (auto [c, entry] : restores) {
+        ComponentData& cd = *c->store;
+        const auto* dense = reinterpret_cast<const uint32_t*>(file->base + entry->denseOffset);
+        unsigned char* data = file->base + entry->dataOffset;
+
+        if (c->soa) {
+            cd.dense.clear();
+            core->reserve(*c, entry->count);
+            for (size_t f = 0; f < c->fields.size(); ++f) {
+                std::memcpy(c->columns[f].get(), data, c->fields[f].size * entry->count);
+                data += c->fields[f].size * entry->count;
+            }
+        } else {
+            if (!c->mapping) std::free(cd.data);
+            cd.data = entry->count ? data : nullptr;
+            cd.capacity = entry->count;
+            c->mapping = entry->count ? file : nullptr;
+        }
+        cd.dense.assign(dense, dense + entry->count);
+
+        c->sparse.clear();
+        const auto* pages = reinterpret_cast<const SparsePageEntry*>(file->base + entry->sparseOffset);
+        const auto* pageData = reinterpret_cast<const uint32_t*>(pages + entry->sparsePages);
+        for (uint64_t p = 0; p < entry->sparsePages; ++p) {
+            if (!pages[p].present) continue;
+            c->sparse.restorePage(p, pageData, pages[p].used);
+            pageData += SparsePages::kPageSize;
+        }
+
+        // Everything restored counts as changed.
+        const size_t capacity = c->soa ? c->columnCapacity : cd.capacity;
+        c->versions.assign((capacity + kChangeBlock - 1) / kChangeBlock, core->m_changeTick.load());
+        core->markGroupsDirty(*c);
+    }
+    return true;
+}
@@ -0,0 +1,103 @@
+// Headless reference host: loads a module through the C ABI and runs it
+// against HostCore for a fixed number of frames.
+//
+// Usage: FractalHost <module> [frames] [threads]
+
+#include "HostCore.h"
+#include <charconv>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+namespace {
+
+using OnLoadFn = void (*)(FractalCORE_Gateway*);
+using OnUnloadFn = void (*)();
+
+struct ModuleLibrary {
+#ifdef _WIN32
+    HMODULE handle = nullptr;
+    explicit ModuleLibrary(const char* path) : handle(LoadLibraryA(path)) {}
+    ~ModuleLibrary() { if (handle) FreeLibrary(handle); }
+    void* symbol(const char* name) const { return reinterpret_cast<void*>(GetProcAddress(handle, name)); }
+    static std::string lastError() { return "LoadLibrary error " + std::to_string(GetLastError()); }
+#else
+    void* handle = nullptr;
+    explicit ModuleLibrary(const char* path) : handle(dlopen(path, RTLD_NOW | RTLD_LOCAL)) {}
+    ~ModuleLibrary() { if (handle) dlclose(handle); }
+    void* symbol(const char* name) const { return dlsym(handle, name); }
+    static std::string lastError() { const char* e = dlerror(); return e ? e : "unknown error"; }
+#endif
+    ModuleLibrary(const ModuleLibrary&) = delete;
+    ModuleLibrary& operator=(const ModuleLibrary&) = delete;
+};
+
+// A whole non-negative decimal number; signs, trailing text and overflow fail.
+bool parseCount(const char* text, size_t& out) {
+    const char* end = text + std::strlen(text);
+    const auto [ptr, ec] = std::from_chars(text, end, out);
+    return ec == std::errc() && ptr == end;
+}
+
+int usage(const char* program) {
+    std::fprintf(stderr, "usage: %s <module> [frames] [threads]\n"
+                         "  frames   frames to run (default 60)\n"
+                         "  threads  worker threads, at least 1 (default: hardware threads)\n", program);
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 4 || argv[1][0] == '-') return usage(argv[0]);
+    size_t frameCount = 60;
+    size_t threads = std::thread::hardware_concurrency();
+    if (argc > 2 && (!parseCount(argv[2], frameCount) || frameCount > INT_MAX)) return usage(argv[0]);
+    if (argc > 3 && (!parseCount(argv[3], threads) || threads == 0)) return usage(argv[0]);
+    const int frames = static_cast<int>(frameCount);
+
+    ModuleLibrary module(argv[1]);
+    if (!module.handle) {
+        std::fprintf(stderr, "failed to load %s: %s\n", argv[1], ModuleLibrary::lastError().c_str());
+        return 1;
+    }
+    auto onLoad = reinterpret_cast<OnLoadFn>(module.symbol("onLoad"));
+    auto onUnload = reinterpret_cast<OnUnloadFn>(module.symbol("onUnload"));
+    if (!onLoad) {
+        std::fprintf(stderr, "%s does not export onLoad\n", argv[1]);
+        return 1;
+    }
+
+    // The core must outlive the module: onUnload may still touch the gateway.
+    HostCore core(threads ? threads : 1);
+    onLoad(core.gateway());
+
+    using clock = std::chrono::steady_clock;
+    double totalMs = 0.0;
+    double worstMs = 0.0;
+    int ran = 0;
+    auto last = clock::now();
+    for (; ran < frames && core.running(); ++ran) {
+        const auto start = clock::now();
+        const float dt = std::chrono::duration<float>(start - last).count();
+        last = start;
+        core.runFrame(dt);
+        const double ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+        totalMs += ms;
+        if (ms > worstMs) worstMs = ms;
+    }
+
+    if (onUnload) onUnload();
+
+    std::printf("frames=%d threads=%zu entities=%zu avg_ms=%.4f max_ms=%.4f\n", ran, core.pool().threadCount(),
+                core.entityCount(), ran ? totalMs / ran : 0.0, worstMs);
+    return 0;
+}
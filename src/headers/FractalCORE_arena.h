@@ -0,0 +1,88 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Bump allocator for contexts that must outlive a registration call
+ * (system trampolines, event subscriptions, profiler wrappers).
+ *
+ * Objects are carved out of 4 KiB blocks and never freed individually;
+ * release() runs their destructors in reverse order and returns the blocks.
+ * Not thread-safe: registration happens on the loading thread.
+ */
+class ContextArena {
+public:
+    ContextArena() = default;
+    ~ContextArena() { release(); }
+
+    ContextArena(const ContextArena&) = delete;
+    ContextArena& operator=(const ContextArena&) = delete;
+
+    template<typename T, typename... Args>
+    T* make(Args&&... args) {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "ContextArena: over-aligned context type");
+        void* memory = allocate(sizeof(T), alignof(T));
+        T* object = ::new (memory) T{ std::forward<Args>(args)... };
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            auto* node = static_cast<DestructorNode*>(allocate(sizeof(DestructorNode), alignof(DestructorNode)));
+            *node = DestructorNode{ [](void* p) { static_cast<T*>(p)->~T(); }, object, m_destructors };
+            m_destructors = node;
+        }
+        return object;
+    }
+
+    /**
+     * @brief Destroys every object made so far and frees all blocks.
+     * Anything still holding a pointer into the arena (e.g. a core that was
+     * not told to drop the module's callbacks) must not use it afterwards.
+     */
+    void release() {
+        for (DestructorNode* node = m_destructors; node; node = node->next) node->destroy(node->object);
+        m_destructors = nullptr;
+        while (m_blocks) {
+            Block* next = m_blocks->next;
+            ::operator delete(m_blocks, std::align_val_t(alignof(std::max_align_t)));
+            m_blocks = next;
+        }
+        m_used = 0;
+        m_capacity = 0;
+    }
+
+private:
+    static constexpr size_t kBlockSize = 4096;
+
+    struct Block {
+        Block* next;
+    };
+
+    struct DestructorNode {
+        void (*destroy)(void*);
+        void* object;
+        DestructorNode* next;
+    };
+
+    void* allocate(size_t size, size_t align) {
+        size_t offset = (m_used + align - 1) & ~(align - 1);
+        if (!m_blocks || offset + size > m_capacity) {
+            const size_t header = (sizeof(Block) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+            const size_t bytes = std::max(kBlockSize, header + size + align);
+            auto* block = static_cast<Block*>(::operator new(bytes, std::align_val_t(alignof(std::max_align_t))));
+            block->next = m_blocks;
+            m_blocks = block;
+            m_used = header;
+            m_capacity = bytes;
+            offset = (m_used + align - 1) & ~(align - 1);
+        }
+        m_used = offset + size;
+        return reinterpret_cast<unsigned char*>(m_blocks) + offset;
+    }
+
+    Block* m_blocks = nullptr;
+    size_t m_used = 0;
+    size_t m_capacity = 0;
+    DestructorNode* m_destructors = nullptr;
+};
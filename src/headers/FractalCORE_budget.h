@@ -0,0 +1,131 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+
+/**
+ * @brief Persistent cursor of a TriggerType::Budgeted system.
+ *
+ * Each frame the system works through its component's dense range in
+ * slices, starting where the previous frame stopped, until the budget is
+ * spent or the range is finished; at least one slice runs per frame so the
+ * system always makes progress. Slices are sized from a smoothed
+ * ns-per-element estimate to about a quarter of the budget, so the last
+ * slice of a frame overshoots by little.
+ *
+ * Elements moved by removals while a sweep is under way may be visited
+ * twice or skipped until the next sweep. report() may be read from any
+ * thread while run() is going on a worker.
+ */
+class BudgetedCursor {
+public:
+    struct Report {
+        std::string label;
+        double budgetMs;
+        // Time the system spent in its last frame.
+        double lastMs;
+        // Elements left in the current sweep and the range size.
+        size_t remaining;
+        size_t count;
+        // Frames and simulated seconds the last complete sweep took, i.e.
+        // how stale an entity gets between two visits.
+        uint64_t framesPerSweep;
+        double secondsPerSweep;
+        uint64_t sweeps;
+    };
+
+    BudgetedCursor(std::string label, std::chrono::nanoseconds budget)
+        : m_label(std::move(label)), m_budget(budget) {}
+
+    /**
+     * @brief Advances the cursor by one frame. `pass(begin, end, dt)`
+     * processes dense elements [begin, end); dt is the time since those
+     * elements were last visited (one sweep).
+     */
+    template<typename Pass>
+    void run(float dt, size_t count, Pass&& pass) {
+        using clock = std::chrono::steady_clock;
+        const auto start = clock::now();
+        float elementDt;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_count = count;
+            m_sweepDt += dt;
+            ++m_sweepFrames;
+            if (count == 0) {
+                m_cursor = 0;
+                m_lastNs = 0;
+                return;
+            }
+            if (m_cursor >= count) m_cursor = 0;
+            // Until a sweep has completed, elements have waited since registration.
+            elementDt = m_sweeps ? m_lastSweepDt : m_sweepDt;
+        }
+
+        // Only run() writes the state, so it reads it unlocked; the lock is
+        // never held across the pass.
+        auto now = start;
+        do {
+            const size_t begin = m_cursor;
+            const size_t end = begin + std::min(m_slice, count - begin);
+            pass(begin, end, elementDt);
+            const auto after = clock::now();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            adapt(after - now, end - begin);
+            now = after;
+            m_cursor = end;
+            if (m_cursor == count) {
+                m_cursor = 0;
+                m_lastSweepDt = m_sweepDt;
+                m_lastSweepFrames = m_sweepFrames;
+                m_sweepDt = 0.0f;
+                m_sweepFrames = 0;
+                ++m_sweeps;
+                break;
+            }
+        } while (now - start < m_budget);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_lastNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count());
+    }
+
+    Report report() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return Report{ m_label,
+                       static_cast<double>(m_budget.count()) / 1e6,
+                       static_cast<double>(m_lastNs) / 1e6,
+                       m_count - std::min(m_cursor, m_count),
+                       m_count,
+                       m_lastSweepFrames,
+                       m_lastSweepDt,
+                       m_sweeps };
+    }
+
+private:
+    static constexpr size_t kMinSlice = 64;
+
+    void adapt(std::chrono::nanoseconds elapsed, size_t elements) {
+        const double sample = std::max(static_cast<double>(elapsed.count()) / static_cast<double>(elements), 0.01);
+        m_nsPerElement = m_nsPerElement == 0.0 ? sample : m_nsPerElement * 0.8 + sample * 0.2;
+        const double target = static_cast<double>(m_budget.count()) / 4.0 / m_nsPerElement;
+        m_slice = std::max(kMinSlice, static_cast<size_t>(target));
+    }
+
+    std::string m_label;
+    std::chrono::nanoseconds m_budget;
+    // Guards the state below against report(); only run() writes it.
+    mutable std::mutex m_mutex;
+    size_t m_slice = kMinSlice;
+    double m_nsPerElement = 0.0;
+    size_t m_cursor = 0;
+    size_t m_count = 0;
+    float m_sweepDt = 0.0f;
+    float m_lastSweepDt = 0.0f;
+    uint64_t m_sweepFrames = 0;
+    uint64_t m_lastSweepFrames = 0;
+    uint64_t m_sweeps = 0;
+    uint64_t m_lastNs = 0;
+};
@@ -0,0 +1,144 @@
+#pragma once
+#include "FractalCORE_profiler.h"
+#include "Structs&Classes.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Pass as chunkSize to let a ChunkTuner pick the chunk size. Distinct
+ * from 0, which keeps meaning "the whole range in one chunk".
+ */
+inline constexpr size_t AutoChunkSize = SIZE_MAX;
+
+/**
+ * @brief Converges a chunk size towards a target per-chunk execution time.
+ *
+ * Each parallel pass records how long every chunk took; at the end of the
+ * pass the tuner updates a smoothed ns-per-element estimate and moves the
+ * chunk size geometrically towards target / estimate, capped so there are
+ * at least four chunks per worker. The result persists across frames.
+ *
+ * Passes sharing a tuner may run concurrently: their chunks then pool into
+ * one sample, taken by whichever pass ends first.
+ */
+class ChunkTuner {
+public:
+    struct Report {
+        std::string label;
+        size_t chunkSize;
+        double nsPerElement;
+        uint64_t passes;
+    };
+
+    explicit ChunkTuner(std::string label,
+                        std::chrono::nanoseconds target = std::chrono::microseconds(50),
+                        size_t initialChunk = 256,
+                        size_t workers = std::thread::hardware_concurrency())
+        : m_label(std::move(label)),
+          m_targetNs(static_cast<double>(target.count())),
+          m_chunkSize(initialChunk),
+          m_workers(std::max<size_t>(workers, 1)) {}
+
+    size_t chunkSize() const { return m_chunkSize.load(std::memory_order_relaxed); }
+
+    // Called concurrently from worker threads, once per chunk.
+    void record(std::chrono::nanoseconds elapsed, size_t elements) {
+        m_passNs.fetch_add(static_cast<uint64_t>(elapsed.count()), std::memory_order_relaxed);
+        m_passElements.fetch_add(elements, std::memory_order_relaxed);
+    }
+
+    // Called once the whole parallel pass has returned.
+    void endPass() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const uint64_t ns = m_passNs.exchange(0, std::memory_order_relaxed);
+        const uint64_t elements = m_passElements.exchange(0, std::memory_order_relaxed);
+        if (elements == 0) return;
+
+        const double sample = std::max(static_cast<double>(ns) / static_cast<double>(elements), 0.01);
+        m_nsPerElement = m_passes == 0 ? sample : m_nsPerElement * 0.8 + sample * 0.2;
+        ++m_passes;
+
+        const double ideal = m_targetNs / m_nsPerElement;
+        const double balanceCap = std::max<double>(kMinChunk, static_cast<double>(elements) / (m_workers * 4));
+        const double goal = std::clamp(ideal, static_cast<double>(kMinChunk), std::max<double>(balanceCap, kMinChunk));
+        const double next = std::sqrt(static_cast<double>(chunkSize()) * goal);
+        m_chunkSize.store(roundChunk(next), std::memory_order_relaxed);
+    }
+
+    Report report() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return Report{ m_label, chunkSize(), m_nsPerElement, m_passes };
+    }
+
+private:
+    static constexpr size_t kMinChunk = 16;
+
+    // Multiples of 8 keep SoA column chunks SIMD-aligned.
+    static size_t roundChunk(double value) {
+        const size_t rounded = static_cast<size_t>(value + 4.0) & ~size_t(7);
+        return std::max(rounded, kMinChunk);
+    }
+
+    std::string m_label;
+    double m_targetNs;
+    std::atomic<size_t> m_chunkSize;
+    size_t m_workers;
+    std::atomic<uint64_t> m_passNs{ 0 };
+    std::atomic<uint64_t> m_passElements{ 0 };
+    // Guards the estimate below, updated once per pass.
+    mutable std::mutex m_mutex;
+    double m_nsPerElement = 0.0;
+    uint64_t m_passes = 0;
+};
+
+namespace chunking_detail {
+
+inline size_t chunkElements(const Entity*, void*, size_t count) { return count; }
+inline size_t chunkElements(const Entity*, const void*, size_t count) { return count; }
+inline size_t chunkElements(const Entity*, void* const*, size_t count) { return count; }
+inline size_t chunkElements(size_t start, size_t end) { return end - start; }
+
+/**
+ * @brief Wraps a raw chunk callback so every chunk is timed into a tuner.
+ * Args are the callback parameters before the trailing user pointer.
+ */
+template<typename... Args>
+struct TimedChunks {
+    void (*inner)(Args..., void*);
+    void* innerCtx;
+    ChunkTuner* tuner;
+
+    static void invoke(Args... args, void* self) {
+        auto* timed = static_cast<TimedChunks*>(self);
+        const auto start = std::chrono::steady_clock::now();
+        timed->inner(args..., timed->innerCtx);
+        timed->tuner->record(std::chrono::steady_clock::now() - start, chunkElements(args...));
+    }
+};
+
+#if FRACTAL_PROFILING
+/**
+ * @brief Wraps a raw chunk callback so every chunk shows up in the profiler.
+ */
+template<typename... Args>
+struct ProfiledChunks {
+    void (*inner)(Args..., void*);
+    void* innerCtx;
+    const char* name;
+
+    static void invoke(Args... args, void* self) {
+        auto* profiled = static_cast<ProfiledChunks*>(self);
+        FRACTAL_PROFILE_SCOPE(profiled->name, Chunk, chunkElements(args...));
+        profiled->inner(args..., profiled->innerCtx);
+    }
+};
+#endif
+
+} // namespace chunking_detail
@@ -0,0 +1,146 @@
+#pragma once
+#include "FractalCORE_handles.h"
+#include "Structs&Classes.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Entity created inside a CommandBuffer; it only gets a real ID at
+ * playback. Only meaningful to the buffer that returned it.
+ */
+struct PendingEntity {
+    uint32_t index;
+};
+
+/**
+ * @brief One thread's recording of deferred structural changes.
+ * Component payloads are copied into a byte arena that keeps its capacity
+ * across frames, so steady-state recording does not allocate.
+ */
+class CommandBuffer {
+public:
+    enum class Kind : uint8_t {
+        Attach,
+        Remove,
+        Destroy
+    };
+
+    struct Command {
+        Kind kind;
+        bool pending;         // entity is a PendingEntity index
+        uint32_t entity;
+        uint32_t componentId;
+        uint32_t size;
+        size_t payloadOffset;
+    };
+
+    PendingEntity createEntity() {
+        return PendingEntity{ m_createdEntities++ };
+    }
+
+    template<typename T>
+    void attachComponent(Entity e, ComponentHandle<T> handle, const T& data) {
+        static_assert(std::is_trivially_copyable_v<T>, "deferred components are copied bytewise");
+        record(Kind::Attach, false, e.id, handle.id, &data, sizeof(T));
+    }
+
+    template<typename T>
+    void attachComponent(PendingEntity e, ComponentHandle<T> handle, const T& data) {
+        static_assert(std::is_trivially_copyable_v<T>, "deferred components are copied bytewise");
+        record(Kind::Attach, true, e.index, handle.id, &data, sizeof(T));
+    }
+
+    template<typename T>
+    void removeComponent(Entity e, ComponentHandle<T> handle) {
+        record(Kind::Remove, false, e.id, handle.id, nullptr, 0);
+    }
+
+    template<typename T>
+    void removeComponent(PendingEntity e, ComponentHandle<T> handle) {
+        record(Kind::Remove, true, e.index, handle.id, nullptr, 0);
+    }
+
+    void destroyEntity(Entity e) {
+        record(Kind::Destroy, false, e.id, 0, nullptr, 0);
+    }
+
+    void destroyEntity(PendingEntity e) {
+        record(Kind::Destroy, true, e.index, 0, nullptr, 0);
+    }
+
+    uint32_t createdEntities() const { return m_createdEntities; }
+    const std::vector<Command>& commands() const { return m_commands; }
+    const std::byte* payload(const Command& c) const { return m_arena.data() + c.payloadOffset; }
+    bool empty() const { return m_commands.empty() && m_createdEntities == 0; }
+
+    void clear() {
+        m_commands.clear();
+        m_arena.clear();
+        m_createdEntities = 0;
+    }
+
+private:
+    void record(Kind kind, bool pending, uint32_t entity, uint32_t componentId, const void* data, size_t size) {
+        const size_t offset = m_arena.size();
+        if (size) {
+            m_arena.resize(offset + size);
+            std::memcpy(m_arena.data() + offset, data, size);
+        }
+        m_commands.push_back(Command{ kind, pending, entity, componentId, static_cast<uint32_t>(size), offset });
+    }
+
+    std::vector<Command> m_commands;
+    std::vector<std::byte> m_arena;
+    uint32_t m_createdEntities = 0;
+};
+
+/**
+ * @brief Set of per-thread CommandBuffers replayed together at a sync point.
+ *
+ * local() returns the calling thread's buffer; after the first call on a
+ * thread it is a lock-free thread_local lookup, so callbacks running inside
+ * updateParallel can record without contention. Replay with
+ * ModuleAPI::playbackCommands() once no worker is recording.
+ */
+class CommandQueue {
+public:
+    CommandQueue() : m_id(nextId()) {}
+
+    CommandQueue(const CommandQueue&) = delete;
+    CommandQueue& operator=(const CommandQueue&) = delete;
+
+    CommandBuffer& local() {
+        thread_local std::vector<std::pair<uint64_t, CommandBuffer*>> cache;
+        for (const auto& [id, buffer] : cache) {
+            if (id == m_id) return *buffer;
+        }
+
+        CommandBuffer* buffer;
+        {
+            std::lock_guard<std::mutex> lock(m_registerMutex);
+            m_buffers.push_back(std::make_unique<CommandBuffer>());
+            buffer = m_buffers.back().get();
+        }
+        cache.emplace_back(m_id, buffer);
+        return *buffer;
+    }
+
+    const std::vector<std::unique_ptr<CommandBuffer>>& buffers() const { return m_buffers; }
+
+private:
+    static uint64_t nextId() {
+        static std::atomic<uint64_t> counter{ 1 };
+        return counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t m_id;
+    std::mutex m_registerMutex;
+    std::vector<std::unique_ptr<CommandBuffer>> m_buffers;
+};
@@ -0,0 +1,130 @@
+#pragma once
+#include "FractalCORE_profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Bounded multi-producer / single-consumer ring of typed events.
+ *
+ * Producers reserve a slot, construct the event in place and commit it, all
+ * without locks, so systems running inside updateParallel can emit freely.
+ * The consumer drains committed events as contiguous spans: one span per
+ * drain, or two when the queued range wraps around the end of the ring.
+ */
+template<typename T>
+class EventStream {
+public:
+    explicit EventStream(size_t capacity = 4096)
+        : m_capacity(std::bit_ceil(capacity < 2 ? size_t(2) : capacity)),
+          m_mask(m_capacity - 1),
+          m_events(std::allocator<T>().allocate(m_capacity)),
+          m_slots(new Slot[m_capacity]) {}
+
+    ~EventStream() {
+        drain([](std::span<const T>) {});
+        std::allocator<T>().deallocate(m_events, m_capacity);
+    }
+
+    EventStream(const EventStream&) = delete;
+    EventStream& operator=(const EventStream&) = delete;
+
+    /**
+     * @brief Reserves a slot and constructs the event in it.
+     * Returns nullptr when the ring is full. The event is invisible to the
+     * consumer until commit() is called with the returned pointer.
+     */
+    template<typename... Args>
+    T* reserve(Args&&... args) {
+        uint64_t seq = m_head.load(std::memory_order_relaxed);
+        do {
+            if (seq - m_tail.load(std::memory_order_acquire) >= m_capacity) return nullptr;
+        } while (!m_head.compare_exchange_weak(seq, seq + 1, std::memory_order_relaxed));
+
+#if FRACTAL_PROFILING
+        if (m_oldestNs.load(std::memory_order_relaxed) == 0) {
+            uint64_t none = 0;
+            m_oldestNs.compare_exchange_strong(none, Profiler::instance().nowNs(), std::memory_order_relaxed);
+        }
+#endif
+        const size_t index = seq & m_mask;
+        m_slots[index].pending = seq;
+        return std::construct_at(m_events + index, std::forward<Args>(args)...);
+    }
+
+    void commit(T* event) {
+        Slot& slot = m_slots[static_cast<size_t>(event - m_events)];
+        slot.committed.store(slot.pending + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief reserve() + commit() in one step. Returns false when full.
+     */
+    template<typename... Args>
+    bool emplace(Args&&... args) {
+        T* event = reserve(std::forward<Args>(args)...);
+        if (!event) return false;
+        commit(event);
+        return true;
+    }
+
+    /**
+     * @brief Consumer side: hands every committed event to f(std::span<const T>)
+     * and releases the slots. Stops at the first slot still being written.
+     * Must only be called from one thread at a time.
+     */
+    template<typename F>
+    size_t drain(F&& f) {
+        const uint64_t begin = m_tail.load(std::memory_order_relaxed);
+        uint64_t end = begin;
+        while (m_slots[end & m_mask].committed.load(std::memory_order_acquire) == end + 1) ++end;
+        if (end == begin) return 0;
+
+        const size_t first = begin & m_mask;
+        const size_t count = static_cast<size_t>(end - begin);
+        const size_t headPart = std::min(count, m_capacity - first);
+        f(std::span<const T>(m_events + first, headPart));
+        if (headPart < count) f(std::span<const T>(m_events, count - headPart));
+
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (uint64_t seq = begin; seq < end; ++seq) std::destroy_at(m_events + (seq & m_mask));
+        }
+        m_tail.store(end, std::memory_order_release);
+        return count;
+    }
+
+    size_t capacity() const { return m_capacity; }
+
+#if FRACTAL_PROFILING
+    /**
+     * @brief Profiler time of the first reserve() since the previous call,
+     * or 0 if there was none; with a call after every drain, when the
+     * oldest drained event was queued.
+     */
+    uint64_t takeOldestNs() { return m_oldestNs.exchange(0, std::memory_order_relaxed); }
+#endif
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> committed{ 0 };
+        uint64_t pending = 0;
+    };
+
+    const size_t m_capacity;
+    const size_t m_mask;
+    T* m_events;
+    std::unique_ptr<Slot[]> m_slots;
+    alignas(64) std::atomic<uint64_t> m_head{ 0 };
+    alignas(64) std::atomic<uint64_t> m_tail{ 0 };
+#if FRACTAL_PROFILING
+    std::atomic<uint64_t> m_oldestNs{ 0 };
+#endif
+};
@@ -6,6 +6,9 @@
 // Forward declarations
 class Clock;
 
+// Marks a gateway whose structSize field is valid ("FCGW").
+inline constexpr uint32_t kGatewayAbiMagic = 0x46434757u;
+
 struct FractalCORE_Gateway {
     void* api; 
 
@@ -54,5 +57,166 @@ struct FractalCORE_Gateway {
     
     // Subscribe callback takes (eventID, EventData, userData)
     void (*subscribe)(void*, uint32_t, void (*)(uint32_t, const EventData&, void*), void*);
+
+    // Entries below were appended after the initial ABI. A core that knows
+    // about them sets abiMagic to kGatewayAbiMagic and structSize to the
+    // sizeof(FractalCORE_Gateway) it was built with. ModuleAPI copies only
+    // the first structSize bytes and treats everything past them as null;
+    // without the magic it keeps just the initial entries. Reading the two
+    // fields is the one access past the initial layout, so cores built
+    // against it must not place the gateway at the very end of a mapping.
+    // Entries a core does not implement are left null.
+    uint32_t abiMagic;
+    uint32_t structSize;
+
+    // --- ECS: Chunked iteration ---
+    // Callback takes (entities, components, count, userData) where `entities`
+    // and `components` point into the same packed range of the dense storage.
+    void (*updateParallelChunks)(void* api,
+                                 const std::string& name,
+                                 void (*func)(const Entity*, void*, size_t, void*),
+                                 void* userContext,
+                                 size_t chunkSize);
+
+    // --- ECS / Events: Interned IDs ---
+    // IDs are hashName() of the registered name. Registration returns false
+    // when the ID is already bound to a different name (hash collision).
+    bool (*registerComponentById)(void*, uint32_t id, const char* name, size_t elementSize, size_t capacity);
+    void (*attachComponentById)(void*, Entity, uint32_t, void*);
+    void (*removeComponentById)(void*, Entity, uint32_t);
+    void* (*getComponentById)(void*, Entity, uint32_t);
+    bool (*hasComponentById)(void*, Entity, uint32_t);
+    ComponentData* (*getComponentDataById)(void*, uint32_t);
+    void (*updateParallelChunksById)(void* api,
+                                     uint32_t id,
+                                     void (*func)(const Entity*, void*, size_t, void*),
+                                     void* userContext,
+                                     size_t chunkSize);
+    bool (*registerEventById)(void*, uint32_t id, const char* name);
+
+    // --- ECS: Bulk Operations ---
+    // Creates `count` entities with consecutive IDs and returns the first one.
+    // Recycling cores may hand out a run of freed slots that share a
+    // generation, so the IDs need not be fresh.
+    Entity (*createEntities)(void*, size_t count);
+    // Attaches `count` components read contiguously from `data`, growing the
+    // component storage once for the whole batch.
+    void (*attachComponentsById)(void*, uint32_t id, const Entity* entities, const void* data, size_t count);
+    // Attaches a copy of the single value at `value` to each of `count` entities.
+    void (*attachComponentFillById)(void*, uint32_t id, const Entity* entities, const void* value, size_t count);
+    void (*removeComponentsById)(void*, uint32_t id, const Entity* entities, size_t count);
+
+    // --- ECS: Structure-of-Arrays Storage ---
+    // Stores each field in its own column aligned to 32 bytes. Attach/remove
+    // still take whole structs of elementSize bytes; the core scatters them
+    // into the columns. Row-based passes (chunk, read, changed and range
+    // passes) still work: each chunk is gathered into structs and, for
+    // mutable passes, scattered back. There is no element to point at, so
+    // getComponent/readComponent throw for SoA components.
+    bool (*registerComponentSoAById)(void*, uint32_t id, const char* name, size_t elementSize,
+                                     const FieldDesc* fields, size_t fieldCount, size_t capacity);
+    // Callback takes (entities, columns, count, userData); columns[i] points at
+    // field i of the chunk's first element. Chunks start on multiples of 8.
+    // Throws for components not stored as columns.
+    void (*updateParallelColumnsById)(void* api,
+                                      uint32_t id,
+                                      void (*func)(const Entity*, void* const*, size_t, void*),
+                                      void* userContext,
+                                      size_t chunkSize);
+
+    // --- ECS: Handle-based Groups ---
+    void (*registerGroupById)(void*, const uint32_t* ids, size_t count);
+    void (*updateParallelGroupById)(void* api,
+                                    const uint32_t* ids,
+                                    size_t count,
+                                    void (*func)(size_t, size_t, void*),
+                                    void* userContext,
+                                    size_t chunkSize);
+
+    // --- ECS: Entity Lifetime ---
+    // Destroying removes every component of the entity and recycles its slot
+    // with a bumped generation; calls with stale handles are ignored. The
+    // 8-bit generation wraps after 256 reuses of a slot.
+    void (*destroyEntity)(void*, Entity);
+    void (*destroyEntities)(void*, const Entity* entities, size_t count);
+    bool (*isAlive)(void*, Entity);
+    // Releases sparse pages and spare dense capacity left behind by destroyed
+    // entities. Returns the number of sparse pages freed.
+    size_t (*compactStorage)(void*);
+
+    // --- ECS: Change Tracking ---
+    // Cores version component storage in blocks of dense elements. A block is
+    // stamped with the current change tick whenever it may have been written:
+    // attach, getComponent/getComponentById, every mutable parallel pass, and
+    // elements moving between slots.
+    // Visits only the blocks stamped after *cursor, then advances *cursor.
+    // The pass itself is read-only and does not stamp. A cursor of 0 visits
+    // everything.
+    void (*updateParallelChangedById)(void* api,
+                                      uint32_t id,
+                                      uint64_t* cursor,
+                                      void (*func)(const Entity*, void*, size_t, void*),
+                                      void* userContext,
+                                      size_t chunkSize);
+    void (*markChangedById)(void*, Entity, uint32_t id);
+    // Same lookup as getComponentById without stamping the block.
+    const void* (*readComponentById)(void*, Entity, uint32_t id);
+
+    // --- Persistence: Snapshots ---
+    // Writes the entity allocator and the listed components (dense, sparse
+    // and element arrays) to `path` as page-aligned sections.
+    bool (*saveSnapshot)(void*, const char* path, const SnapshotLayout* layouts, size_t count);
+    // Restores the allocator and the listed components from a snapshot. The
+    // element sections may be mapped straight from the file. If any listed
+    // component is missing or its elementSize/layoutHash differs, nothing is
+    // touched and false is returned.
+    bool (*loadSnapshot)(void*, const char* path, const SnapshotLayout* layouts, size_t count);
+
+    // --- ECS: Read-only Iteration ---
+    // Same chunks as updateParallelChunksById, but the pass promises not to
+    // write, so no block is stamped. Chunks start on multiples of chunkSize.
+    void (*readParallelChunksById)(void* api,
+                                   uint32_t id,
+                                   void (*func)(const Entity*, const void*, size_t, void*),
+                                   void* userContext,
+                                   size_t chunkSize);
+
+    // --- Task System: Inline Tasks ---
+    // Moves *task out and queues it on the core's pool. With a group, the
+    // task counts towards the group until it has finished.
+    void (*submitTask)(void*, InlineTask* task, WaitGroup* group);
+    // Queues *task once every task counted by `group` has finished (or now,
+    // if none is pending); the continuation counts towards `next`, which may
+    // be null.
+    void (*continueWith)(void*, WaitGroup* group, InlineTask* task, WaitGroup* next);
+    // Runs queued tasks on the calling thread until `group` is done.
+    void (*waitGroup)(void*, WaitGroup* group);
+    // Moves *task onto the core's timer wheel and returns an ID for
+    // cancelTickTask. Both may be called from any thread.
+    uint64_t (*scheduleTickTask)(void*, InlineTask* task, const TickTaskDesc* desc);
+    bool (*cancelTickTask)(void*, uint64_t id);
+
+    // --- ECS: Partial Iteration ---
+    // Mutable chunk pass over dense elements [begin, end) only, stamping just
+    // that range. Chunks start at begin + a multiple of chunkSize; a range
+    // past the end of the component is clipped.
+    void (*updateParallelRangeById)(void* api,
+                                    uint32_t id,
+                                    size_t begin,
+                                    size_t end,
+                                    void (*func)(const Entity*, void*, size_t, void*),
+                                    void* userContext,
+                                    size_t chunkSize);
+
+    // --- ECS: System Access ---
+    // Declares the components a system reads and writes and its ordering
+    // against other systems, for cores that run systems concurrently. May
+    // come before or after registerSystemInLoop. Systems never declared are
+    // treated as touching every component.
+    void (*registerSystemAccess)(void*, const char* systemName, const SystemAccess* access);
+
+    // --- Tasks: Worker Pool ---
+    // Number of threads the parallel passes are spread over.
+    size_t (*workerCount)(void* api);
 };
 
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief 32-bit FNV-1a hash of a component/event name.
+ * Used as the stable ID behind ComponentHandle and EventHandle so hot paths
+ * can be written against compile-time constants instead of strings.
+ */
+constexpr uint32_t hashName(std::string_view name) {
+    uint32_t hash = 2166136261u;
+    for (char c : name) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Typed, interned handle to a registered component type.
+ */
+template<typename T>
+struct ComponentHandle {
+    uint32_t id = 0;
+
+    constexpr bool operator==(const ComponentHandle&) const = default;
+};
+
+/**
+ * @brief Typed, interned handle to a registered event type.
+ */
+template<typename T>
+struct EventHandle {
+    uint32_t id = 0;
+
+    constexpr bool operator==(const EventHandle&) const = default;
+};
+
+template<typename T>
+constexpr ComponentHandle<T> makeComponentHandle(std::string_view name) {
+    return ComponentHandle<T>{ hashName(name) };
+}
+
+template<typename T>
+constexpr EventHandle<T> makeEventHandle(std::string_view name) {
+    return EventHandle<T>{ hashName(name) };
+}
@@ -0,0 +1,372 @@
+#pragma once
+#include "Structs&Classes.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Growable ring buffer used as a worker's job deque. Unlike
+ * std::deque it keeps its storage once grown, so a pool at steady state
+ * queues jobs without touching the heap.
+ */
+template<typename T>
+class RingDeque {
+public:
+    bool empty() const { return m_head == m_tail; }
+
+    void pushBack(T value) {
+        if (m_tail - m_head == m_items.size()) grow();
+        m_items[m_tail++ & (m_items.size() - 1)] = std::move(value);
+    }
+    T popBack() { return std::move(m_items[--m_tail & (m_items.size() - 1)]); }
+    T popFront() { return std::move(m_items[m_head++ & (m_items.size() - 1)]); }
+
+private:
+    void grow() {
+        std::vector<T> items(std::max<size_t>(m_items.size() * 2, 64));
+        for (size_t i = m_head; i != m_tail; ++i) items[i - m_head] = std::move(m_items[i & (m_items.size() - 1)]);
+        m_tail -= m_head;
+        m_head = 0;
+        m_items.swap(items);
+    }
+
+    std::vector<T> m_items;
+    size_t m_head = 0;
+    size_t m_tail = 0;
+};
+
+/**
+ * @brief Fixed-size thread pool with one deque per worker.
+ *
+ * Workers pop their own deque from the back (LIFO, cache-warm) and steal
+ * from the front of other workers' deques when they run dry. Threads that
+ * wait for work through runUntilDone() or wait() execute tasks too, so
+ * waiting from inside a task cannot deadlock the pool. Jobs are InlineTasks
+ * in ring-buffer deques, so a warm pool queues them without allocating.
+ */
+class WorkStealingPool {
+public:
+    using Job = InlineTask;
+
+    explicit WorkStealingPool(size_t threads = std::thread::hardware_concurrency())
+        : m_queues(std::max<size_t>(threads, 1)) {
+        for (auto& q : m_queues) q = std::make_unique<Queue>();
+        m_workers.reserve(m_queues.size());
+        for (size_t i = 0; i < m_queues.size(); ++i) {
+            m_workers.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            m_stopping = true;
+        }
+        m_sleepCv.notify_all();
+        for (auto& t : m_workers) t.join();
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    size_t threadCount() const { return m_workers.size(); }
+
+    /**
+     * @brief Queues a job; from a worker it goes to that worker's own deque.
+     * With a group, the job counts towards it until it has finished.
+     */
+    void submit(Job job, WaitGroup* group = nullptr) {
+        if (group) group->pending.fetch_add(1, std::memory_order_relaxed);
+        push(Queued{ std::move(job), group });
+    }
+
+    /**
+     * @brief Arms `group` so that `job` is submitted once every task counted
+     * by the group has finished (right away if none is pending), counted
+     * towards `next`. Arm after submitting the group's tasks; a group holds
+     * one continuation at a time.
+     */
+    void continueWith(WaitGroup& group, Job job, WaitGroup* next = nullptr) {
+        if (next) next->pending.fetch_add(1, std::memory_order_relaxed);
+        group.continuation = std::move(job);
+        group.continuationGroup = next;
+        if (group.pending.fetch_or(WaitGroup::kArmed, std::memory_order_acq_rel) == 0) fire(group);
+    }
+
+    /**
+     * @brief Runs queued jobs on the calling thread until `group` is done.
+     */
+    void wait(const WaitGroup& group) { runUntilDone(group.pending); }
+
+    /**
+     * @brief Runs queued jobs on the calling thread until `remaining` hits zero.
+     */
+    void runUntilDone(const std::atomic<size_t>& remaining) {
+        const size_t home = t_workerIndex.pool == this ? t_workerIndex.index : 0;
+        while (remaining.load(std::memory_order_acquire) != 0) {
+            Queued job;
+            if (tryTake(home, job)) run(job);
+            else std::this_thread::yield();
+        }
+    }
+
+private:
+    struct Queued {
+        Job job;
+        WaitGroup* group = nullptr;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        RingDeque<Queued> jobs;
+    };
+
+    void push(Queued queued) {
+        const size_t index = t_workerIndex.pool == this
+            ? t_workerIndex.index
+            : m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+        // Count first so a thief never sees the job before it is counted.
+        m_pending.fetch_add(1, std::memory_order_seq_cst);
+        {
+            std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+            m_queues[index]->jobs.pushBack(std::move(queued));
+        }
+        // Pairs with workerLoop: either this sees the sleeper or the sleeper
+        // sees the job, so the sleep lock is only taken when someone waits.
+        if (m_sleepers.load(std::memory_order_seq_cst) == 0) return;
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+        m_sleepCv.notify_one();
+    }
+
+    void run(Queued& queued) {
+        queued.job();
+        queued.job.reset();
+        WaitGroup* group = queued.group;
+        if (!group) return;
+        // Unless this was the last task of an armed group, the decrement is
+        // the last access: a waiter may destroy the group right after it.
+        if (group->pending.fetch_sub(1, std::memory_order_acq_rel) == (WaitGroup::kArmed | 1)) fire(*group);
+    }
+
+    // Only reached by whoever saw the count hit zero with the group armed.
+    // The armed bit keeps waiters blocked until the continuation is queued.
+    void fire(WaitGroup& group) {
+        push(Queued{ std::move(group.continuation), group.continuationGroup });
+        group.continuationGroup = nullptr;
+        group.pending.fetch_and(~WaitGroup::kArmed, std::memory_order_release);
+    }
+
+    // Zero-initialized per thread: pool is null outside this pool's workers.
+    struct WorkerIndex {
+        const WorkStealingPool* pool;
+        size_t index;
+    };
+    static inline thread_local WorkerIndex t_workerIndex{};
+
+    bool tryTake(size_t home, Queued& out) {
+        {
+            Queue& own = *m_queues[home];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.jobs.empty()) {
+                out = own.jobs.popBack();
+                m_pending.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        for (size_t k = 1; k < m_queues.size(); ++k) {
+            Queue& victim = *m_queues[(home + k) % m_queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.jobs.empty()) {
+                out = victim.jobs.popFront();
+                m_pending.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(size_t index) {
+        t_workerIndex = WorkerIndex{ this, index };
+        for (;;) {
+            Queued job;
+            if (tryTake(index, job)) {
+                run(job);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+            m_sleepCv.wait(lock, [this] {
+                return m_stopping || m_pending.load(std::memory_order_seq_cst) != 0;
+            });
+            m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+            if (m_stopping && m_pending.load(std::memory_order_acquire) == 0) return;
+        }
+    }
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread> m_workers;
+    std::atomic<size_t> m_pending{ 0 };
+    // Workers inside the sleep wait; changed under m_sleepMutex.
+    std::atomic<size_t> m_sleepers{ 0 };
+    std::atomic<size_t> m_nextQueue{ 0 };
+    std::mutex m_sleepMutex;
+    std::condition_variable m_sleepCv;
+    bool m_stopping = false;
+};
+
+/**
+ * @brief Hashed timing wheel for interval tasks, in 1 ms ticks.
+ *
+ * A timer sits in the slot of its next deadline; advance() only visits the
+ * slots the clock moved across since the last call, so the cost per frame
+ * is the number of elapsed ticks plus the timers that share those slots,
+ * independent of how many timers exist in total. Timers further out than
+ * one revolution stay in place and are skipped until their deadline comes
+ * round. add and cancel may be called from any thread, including from a
+ * running task; new timers are staged and join the wheel on the next
+ * advance(), which must always be called from the same thread.
+ */
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr size_t kSlots = 512;
+
+    struct Timer {
+        InlineTask task;
+        uint64_t id = 0;
+        uint64_t deadline = 0;
+        uint32_t interval = 1;
+        uint32_t remaining = 0;
+        bool isBackTask = true;
+        std::atomic<bool> cancelled{ false };
+        // Set while a background run is queued or executing; the timer is
+        // neither fired again nor freed until it clears.
+        std::atomic<bool> running{ false };
+    };
+
+    explicit TimerWheel(Clock::time_point start = Clock::now()) : m_start(start) {}
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_timers.size();
+    }
+
+    uint64_t add(InlineTask task, const TickTaskDesc& desc, Clock::time_point now = Clock::now()) {
+        auto timer = std::make_unique<Timer>();
+        timer->task = std::move(task);
+        timer->id = m_nextId.fetch_add(1, std::memory_order_relaxed) + 1;
+        timer->interval = std::max<uint32_t>(desc.intervalMs, 1);
+        timer->remaining = desc.executions;
+        timer->isBackTask = desc.isBackTask;
+        // Until the timer is staged in, deadline holds the tick it was added at.
+        timer->deadline = ticks(now);
+        const uint64_t id = timer->id;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_staged.push_back(timer.get());
+        m_timers.emplace(id, std::move(timer));
+        return id;
+    }
+
+    // Stops future runs; a background run already under way completes.
+    bool cancel(uint64_t id) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_timers.find(id);
+        return it != m_timers.end() && !it->second->cancelled.exchange(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Calls fire(Timer&) for every timer due by `now`, at most once
+     * each, and reschedules it `interval` ticks later.
+     */
+    template<typename Fire>
+    void advance(Clock::time_point now, Fire&& fire) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            purgeRetired();
+            for (Timer* timer : m_staged) {
+                timer->deadline = std::max(timer->deadline, m_tick) + timer->interval;
+                m_slots[timer->deadline % kSlots].push_back(timer);
+            }
+            m_staged.clear();
+        }
+        // Fired tasks may add or cancel timers, so the wheel is walked unlocked.
+        const uint64_t target = ticks(now);
+        if (target <= m_tick) return;
+        const uint64_t steps = std::min<uint64_t>(target - m_tick, kSlots);
+        for (uint64_t step = 1; step <= steps; ++step) {
+            std::vector<Timer*>& slot = m_slots[(m_tick + step) % kSlots];
+            for (size_t i = 0; i < slot.size();) {
+                Timer* timer = slot[i];
+                const bool cancelled = timer->cancelled.load(std::memory_order_relaxed);
+                if (!cancelled && timer->deadline > target) {
+                    ++i;
+                    continue;
+                }
+                slot[i] = slot.back();
+                slot.pop_back();
+                if (cancelled) {
+                    retire(timer);
+                    continue;
+                }
+                // A background run still going from last time: try again next tick.
+                uint64_t next = target + 1;
+                if (!timer->running.load(std::memory_order_acquire)) {
+                    fire(*timer);
+                    if (timer->remaining > 0 && --timer->remaining == 0) {
+                        retire(timer);
+                        continue;
+                    }
+                    next = target + timer->interval;
+                }
+                timer->deadline = next;
+                m_slots[next % kSlots].push_back(timer);
+            }
+        }
+        m_tick = target;
+    }
+
+private:
+    uint64_t ticks(Clock::time_point t) const {
+        if (t <= m_start) return 0;
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(t - m_start).count());
+    }
+
+    void retire(Timer* timer) { m_retired.push_back(timer); }
+
+    // Frees finished timers once no background run refers to them. Called
+    // with m_mutex held.
+    void purgeRetired() {
+        for (size_t i = 0; i < m_retired.size();) {
+            Timer* timer = m_retired[i];
+            if (timer->running.load(std::memory_order_acquire)) {
+                ++i;
+                continue;
+            }
+            m_retired[i] = m_retired.back();
+            m_retired.pop_back();
+            m_timers.erase(timer->id);
+        }
+    }
+
+    Clock::time_point m_start;
+    // The wheel itself belongs to the thread calling advance().
+    uint64_t m_tick = 0;
+    std::vector<Timer*> m_slots[kSlots];
+    std::vector<Timer*> m_retired;
+
+    // Guards m_timers and m_staged.
+    mutable std::mutex m_mutex;
+    std::atomic<uint64_t> m_nextId{ 0 };
+    std::vector<Timer*> m_staged;
+    std::unordered_map<uint64_t, std::unique_ptr<Timer>> m_timers;
+};
@@ -0,0 +1,263 @@
+#pragma once
+
+/**
+ * Frame profiler for systems, parallel chunks and event dispatch.
+ *
+ * Enabled by defining FRACTAL_PROFILING=1 (CMake: MODULE_ENABLE_PROFILING).
+ * When it is 0 the FRACTAL_PROFILE_* macros expand to nothing and the
+ * wrapper's instrumentation compiles out entirely.
+ *
+ * Every thread records completed scopes into its own fixed-size ring
+ * (single producer, single consumer, no locks on the recording path).
+ * Profiler::collect() drains the rings into a bounded history that can be
+ * written as Chrome trace / Perfetto JSON and into rolling per-name stats.
+ */
+
+#ifndef FRACTAL_PROFILING
+#define FRACTAL_PROFILING 0
+#endif
+
+#if FRACTAL_PROFILING
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+enum class ProfileCategory : uint8_t {
+    System,
+    Chunk,
+    Event,
+    Task,
+    User
+};
+
+struct ProfileRecord {
+    const char* name;       // interned, lives as long as the Profiler
+    uint64_t startNs;
+    uint64_t endNs;
+    uint64_t arg;           // elements in a chunk, events in a dispatch, ...
+    uint32_t threadId;
+    ProfileCategory category;
+};
+
+class Profiler {
+public:
+    struct Stats {
+        std::string name;
+        ProfileCategory category;
+        uint64_t count = 0;
+        uint64_t totalArg = 0;
+        double lastMs = 0.0;
+        double avgMs = 0.0;   // exponential moving average over samples
+        double maxMs = 0.0;   // max since the last resetStats()
+    };
+
+    static Profiler& instance() {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    uint64_t nowNs() const {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - m_epoch).count());
+    }
+
+    /**
+     * @brief Returns a stable C string for a runtime name (system, component).
+     */
+    const char* intern(std::string_view name) {
+        std::lock_guard<std::mutex> lock(m_internMutex);
+        return m_names.emplace(name).first->c_str();
+    }
+
+    void record(const char* name, ProfileCategory category, uint64_t startNs, uint64_t endNs, uint64_t arg = 0) {
+        ThreadRing& ring = localRing();
+        const uint64_t head = ring.head.load(std::memory_order_relaxed);
+        if (head - ring.tail.load(std::memory_order_acquire) >= kRingCapacity) {
+            ring.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        ring.records[head & (kRingCapacity - 1)] = ProfileRecord{ name, startNs, endNs, arg, ring.threadId, category };
+        ring.head.store(head + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Drains every thread's ring into the history and the stats.
+     * Call from one thread, e.g. once per frame.
+     */
+    void collect() {
+        std::lock_guard<std::mutex> lock(m_collectMutex);
+        std::vector<ThreadRing*> rings;
+        {
+            std::lock_guard<std::mutex> ringLock(m_ringMutex);
+            for (auto& ring : m_rings) rings.push_back(ring.get());
+        }
+        for (ThreadRing* ring : rings) {
+            const uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+            const uint64_t head = ring->head.load(std::memory_order_acquire);
+            for (uint64_t i = tail; i < head; ++i) {
+                const ProfileRecord& r = ring->records[i & (kRingCapacity - 1)];
+                accumulate(r);
+                m_history.push_back(r);
+            }
+            ring->tail.store(head, std::memory_order_release);
+        }
+        while (m_history.size() > m_historyLimit) m_history.pop_front();
+    }
+
+    void setHistoryLimit(size_t records) { m_historyLimit = records; }
+
+    std::vector<Stats> summary() const {
+        std::lock_guard<std::mutex> lock(m_collectMutex);
+        std::vector<Stats> out;
+        out.reserve(m_stats.size());
+        for (const auto& [name, stats] : m_stats) out.push_back(stats);
+        std::sort(out.begin(), out.end(), [](const Stats& a, const Stats& b) { return a.avgMs > b.avgMs; });
+        return out;
+    }
+
+    void resetStats() {
+        std::lock_guard<std::mutex> lock(m_collectMutex);
+        for (auto& [name, stats] : m_stats) stats.maxMs = 0.0;
+    }
+
+    uint64_t droppedRecords() const {
+        std::lock_guard<std::mutex> lock(m_ringMutex);
+        uint64_t dropped = 0;
+        for (const auto& ring : m_rings) dropped += ring->dropped.load(std::memory_order_relaxed);
+        return dropped;
+    }
+
+    /**
+     * @brief Writes the collected history as Chrome trace event JSON,
+     * loadable in chrome://tracing and ui.perfetto.dev.
+     */
+    void writeChromeTrace(std::ostream& out) const {
+        std::lock_guard<std::mutex> lock(m_collectMutex);
+        out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        bool first = true;
+        for (const ProfileRecord& r : m_history) {
+            out << (first ? "" : ",") << "\n{\"name\":\"";
+            writeEscaped(out, r.name);
+            out << "\",\"cat\":\"" << categoryName(r.category) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << r.threadId
+                << ",\"ts\":" << static_cast<double>(r.startNs) / 1000.0
+                << ",\"dur\":" << static_cast<double>(r.endNs - r.startNs) / 1000.0
+                << ",\"args\":{\"n\":" << r.arg << "}}";
+            first = false;
+        }
+        out << "\n]}\n";
+    }
+
+    static const char* categoryName(ProfileCategory category) {
+        switch (category) {
+        case ProfileCategory::System: return "system";
+        case ProfileCategory::Chunk: return "chunk";
+        case ProfileCategory::Event: return "event";
+        case ProfileCategory::Task: return "task";
+        case ProfileCategory::User: return "user";
+        }
+        return "user";
+    }
+
+private:
+    static constexpr size_t kRingCapacity = 1 << 14;
+
+    struct ThreadRing {
+        std::unique_ptr<ProfileRecord[]> records{ new ProfileRecord[kRingCapacity] };
+        alignas(64) std::atomic<uint64_t> head{ 0 };
+        alignas(64) std::atomic<uint64_t> tail{ 0 };
+        std::atomic<uint64_t> dropped{ 0 };
+        uint32_t threadId = 0;
+    };
+
+    Profiler() : m_epoch(std::chrono::steady_clock::now()) {}
+
+    ThreadRing& localRing() {
+        thread_local ThreadRing* ring = nullptr;
+        if (!ring) {
+            std::lock_guard<std::mutex> lock(m_ringMutex);
+            m_rings.push_back(std::make_unique<ThreadRing>());
+            ring = m_rings.back().get();
+            ring->threadId = static_cast<uint32_t>(m_rings.size());
+        }
+        return *ring;
+    }
+
+    void accumulate(const ProfileRecord& r) {
+        Stats& s = m_stats[r.name];
+        const double ms = static_cast<double>(r.endNs - r.startNs) / 1e6;
+        if (s.count == 0) {
+            s.name = r.name;
+            s.category = r.category;
+            s.avgMs = ms;
+        } else {
+            s.avgMs = s.avgMs * 0.95 + ms * 0.05;
+        }
+        ++s.count;
+        s.totalArg += r.arg;
+        s.lastMs = ms;
+        s.maxMs = std::max(s.maxMs, ms);
+    }
+
+    static void writeEscaped(std::ostream& out, const char* text) {
+        for (const char* c = text; *c; ++c) {
+            if (*c == '"' || *c == '\\') out << '\\';
+            out << *c;
+        }
+    }
+
+    std::chrono::steady_clock::time_point m_epoch;
+    std::mutex m_internMutex;
+    std::unordered_set<std::string> m_names;
+    mutable std::mutex m_ringMutex;
+    std::vector<std::unique_ptr<ThreadRing>> m_rings;
+    mutable std::mutex m_collectMutex;
+    std::deque<ProfileRecord> m_history;
+    size_t m_historyLimit = 1 << 20;
+    std::unordered_map<const char*, Stats> m_stats;
+};
+
+/**
+ * @brief Records the enclosing scope into the calling thread's ring.
+ */
+class ProfileScope {
+public:
+    ProfileScope(const char* name, ProfileCategory category, uint64_t arg = 0)
+        : m_name(name), m_category(category), m_arg(arg), m_start(Profiler::instance().nowNs()) {}
+
+    ~ProfileScope() {
+        Profiler& profiler = Profiler::instance();
+        profiler.record(m_name, m_category, m_start, profiler.nowNs(), m_arg);
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* m_name;
+    ProfileCategory m_category;
+    uint64_t m_arg;
+    uint64_t m_start;
+};
+
+#define FRACTAL_PROFILE_CONCAT_INNER(a, b) a##b
+#define FRACTAL_PROFILE_CONCAT(a, b) FRACTAL_PROFILE_CONCAT_INNER(a, b)
+#define FRACTAL_PROFILE_SCOPE(name, category, arg) \
+    ProfileScope FRACTAL_PROFILE_CONCAT(fractalProfileScope_, __LINE__)((name), ProfileCategory::category, (arg))
+
+#else
+
+#define FRACTAL_PROFILE_SCOPE(name, category, arg) ((void)0)
+
+#endif
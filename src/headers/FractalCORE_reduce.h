@@ -0,0 +1,127 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <vector>
+
+namespace reduce_detail {
+
+inline constexpr size_t kCacheLine = 64;
+
+/**
+ * @brief One chunk's partial result, padded to its own cache line so
+ * workers folding neighbouring chunks never share a line. `start` is the
+ * chunk's first element, which orders the partials for combining.
+ */
+template<typename Acc>
+struct alignas(kCacheLine) alignas(Acc) Slot {
+    Acc value;
+    size_t start = 0;
+};
+
+/**
+ * @brief Per-thread partial buffer for one accumulator type, reused across
+ * calls so a warm reduce does not allocate. A reduce started from inside
+ * another reduce of the same type on the same thread gets its own buffer.
+ */
+template<typename Acc>
+class SlotLease {
+public:
+    SlotLease(size_t count, const Acc& init) : m_slots(acquire()) {
+        m_slots->assign(count, Slot<Acc>{ init });
+    }
+    ~SlotLease() {
+        if (m_slots == &cached()) {
+            m_slots->clear();
+            busy() = false;
+        }
+    }
+    SlotLease(const SlotLease&) = delete;
+    SlotLease& operator=(const SlotLease&) = delete;
+
+    Slot<Acc>* data() { return m_slots->data(); }
+    size_t size() const { return m_slots->size(); }
+
+private:
+    static std::vector<Slot<Acc>>& cached() {
+        thread_local std::vector<Slot<Acc>> slots;
+        return slots;
+    }
+    static bool& busy() {
+        thread_local bool inUse = false;
+        return inUse;
+    }
+    std::vector<Slot<Acc>>* acquire() {
+        if (busy()) return &m_nested;
+        busy() = true;
+        return &cached();
+    }
+
+    std::vector<Slot<Acc>> m_nested;
+    std::vector<Slot<Acc>>* m_slots;
+};
+
+/**
+ * @brief Folds slots pairwise in a fixed tree: (0,1) (2,3) ..., then
+ * (0,2) (4,6) ..., leaving the result in slot 0. The order only depends on
+ * the slot count, so it is the same whatever thread filled which slot.
+ */
+template<typename Acc>
+void treeCombine(Slot<Acc>* slots, size_t count, void (*combine)(Acc&, const Acc&)) {
+    for (size_t stride = 1; stride < count; stride *= 2) {
+        for (size_t i = 0; i + stride < count; i += stride * 2) combine(slots[i].value, slots[i + stride].value);
+    }
+}
+
+/**
+ * @brief The partials of one reduce. Each chunk claims the next free slot
+ * and records where it starts, so nothing assumes the core splits the range
+ * on multiples of the requested chunk size; chunks past the `expected`
+ * leased slots spill into a locked list. finish() sorts the partials by
+ * start and tree-combines them, so the result only depends on where the
+ * chunk boundaries fall.
+ */
+template<typename Acc>
+class Partials {
+public:
+    Partials(size_t expected, const Acc& init) : m_lease(expected, init), m_init(init) {}
+
+    Acc& claim(size_t start) {
+        const size_t i = m_next.fetch_add(1, std::memory_order_relaxed);
+        if (i < m_lease.size()) {
+            Slot<Acc>& slot = m_lease.data()[i];
+            slot.start = start;
+            return slot.value;
+        }
+        std::lock_guard<std::mutex> lock(m_spillMutex);
+        return m_spill.emplace_back(Slot<Acc>{ m_init, start }).value;
+    }
+
+    // Call once every chunk has finished.
+    Acc finish(void (*combine)(Acc&, const Acc&)) {
+        Slot<Acc>* slots = m_lease.data();
+        size_t count = std::min(m_next.load(std::memory_order_relaxed), m_lease.size());
+        std::vector<Slot<Acc>> merged;
+        if (!m_spill.empty()) {
+            merged.assign(slots, slots + count);
+            merged.insert(merged.end(), m_spill.begin(), m_spill.end());
+            slots = merged.data();
+            count = merged.size();
+        }
+        if (count == 0) return m_init;
+        std::sort(slots, slots + count, [](const Slot<Acc>& a, const Slot<Acc>& b) { return a.start < b.start; });
+        treeCombine(slots, count, combine);
+        return slots[0].value;
+    }
+
+private:
+    SlotLease<Acc> m_lease;
+    Acc m_init;
+    std::atomic<size_t> m_next{ 0 };
+    std::mutex m_spillMutex;
+    std::list<Slot<Acc>> m_spill;
+};
+
+} // namespace reduce_detail
@@ -0,0 +1,244 @@
+#pragma once
+#include "FractalCORE_jobs.h"
+#include "Structs&Classes.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Runs registered systems each frame as a dependency DAG.
+ *
+ * Mirrors the gateway's registerSystem/registerSystemInLoop/
+ * registerSystemAccess entries so a core can forward them here. Every frame
+ * the systems that are due are ordered by their explicit runBefore/runAfter
+ * constraints (registration order breaks ties); any two that conflict on a
+ * component (write/write or read/write, or either declares no access at all)
+ * keep that order, and everything else runs concurrently on the pool.
+ *
+ * Only declared access is known: a system whose callback touches a
+ * component it did not declare (say through getComponent) races with the
+ * systems writing it. The graph is cached and rebuilt only after a
+ * registration or when the set of due systems changes.
+ */
+class SystemScheduler {
+public:
+    using SystemFunc = void (*)(float, void*);
+
+    explicit SystemScheduler(WorkStealingPool& pool) : m_pool(pool) {}
+
+    void registerSystem(const std::string& name, SystemFunc func, void* userData) {
+        Entry& entry = entryFor(name);
+        entry.func = func;
+        entry.userData = userData;
+        m_graphValid = false;
+    }
+
+    void registerSystemInLoop(const SystemDesc& desc) {
+        Entry& entry = entryFor(desc.systemName);
+        entry.desc = desc;
+        entry.configured = true;
+        m_graphValid = false;
+    }
+
+    void setAccess(const std::string& name, const SystemAccess& access) {
+        Entry& entry = entryFor(name);
+        entry.reads.assign(access.reads, access.reads + access.readCount);
+        entry.writes.assign(access.writes, access.writes + access.writeCount);
+        entry.runBefore.assign(access.runBefore, access.runBefore + access.runBeforeCount);
+        entry.runAfter.assign(access.runAfter, access.runAfter + access.runAfterCount);
+        sortAccess(entry.reads);
+        sortAccess(entry.writes);
+        m_graphValid = false;
+    }
+
+    void setEnabled(const std::string& name, bool enabled) {
+        auto it = m_index.find(name);
+        if (it != m_index.end()) m_systems[it->second].desc.enabled = enabled;
+    }
+
+    /**
+     * @brief Runs every due system once, blocking until all have finished.
+     */
+    void runFrame(float dt) {
+        m_due.clear();
+        for (size_t i = 0; i < m_systems.size(); ++i) {
+            if (isDue(m_systems[i], dt)) m_due.push_back(i);
+        }
+        if (m_due.empty()) return;
+
+        if (!m_graphValid || !graphCovers(m_due)) {
+            buildGraph(m_due);
+            m_graphValid = true;
+        }
+
+        std::atomic<size_t> remaining{ m_nodes.size() };
+        for (Node& node : m_nodes) node.unmet.store(node.dependencies, std::memory_order_relaxed);
+        for (size_t n = 0; n < m_nodes.size(); ++n) {
+            if (m_nodes[n].dependencies == 0) launch(n, dt, remaining);
+        }
+        m_pool.runUntilDone(remaining);
+    }
+
+private:
+    struct Entry {
+        SystemFunc func = nullptr;
+        void* userData = nullptr;
+        SystemDesc desc;
+        bool configured = false;
+        std::vector<uint32_t> reads;
+        std::vector<uint32_t> writes;
+        std::vector<std::string> runBefore;
+        std::vector<std::string> runAfter;
+    };
+
+    struct Node {
+        size_t system;
+        size_t dependencies = 0;
+        std::atomic<size_t> unmet{ 0 };
+        std::vector<size_t> successors;
+    };
+
+    Entry& entryFor(const std::string& name) {
+        auto it = m_index.find(name);
+        if (it != m_index.end()) return m_systems[it->second];
+        m_index.emplace(name, m_systems.size());
+        m_systems.emplace_back();
+        m_systems.back().desc.systemName = name;
+        return m_systems.back();
+    }
+
+    static void sortAccess(std::vector<uint32_t>& ids) {
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    }
+
+    static bool intersects(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+        auto i = a.begin();
+        auto j = b.begin();
+        while (i != a.end() && j != b.end()) {
+            if (*i == *j) return true;
+            if (*i < *j) ++i; else ++j;
+        }
+        return false;
+    }
+
+    bool graphCovers(const std::vector<size_t>& due) const {
+        if (m_nodes.size() != due.size()) return false;
+        for (size_t i = 0; i < due.size(); ++i) {
+            if (m_nodes[i].system != due[i]) return false;
+        }
+        return true;
+    }
+
+    static bool conflicts(const Entry& a, const Entry& b) {
+        const bool aUndeclared = a.reads.empty() && a.writes.empty();
+        const bool bUndeclared = b.reads.empty() && b.writes.empty();
+        if (aUndeclared || bUndeclared) return true;
+        return intersects(a.writes, b.writes) || intersects(a.writes, b.reads) || intersects(a.reads, b.writes);
+    }
+
+    static bool isDue(Entry& entry, float dt) {
+        SystemDesc& desc = entry.desc;
+        if (!entry.func || !entry.configured || !desc.enabled) return false;
+        switch (desc.trigger) {
+        case TriggerType::Always:
+        case TriggerType::OnChanged:
+        case TriggerType::Budgeted:
+            return true;
+        case TriggerType::TimeInterval:
+            desc.timeAcc += dt;
+            if (desc.timeAcc < desc.timeInterval) return false;
+            desc.timeAcc -= desc.timeInterval;
+            return true;
+        case TriggerType::TickInterval:
+            if (++desc.tickAcc < desc.tickInterval) return false;
+            desc.tickAcc = 0;
+            return true;
+        }
+        return false;
+    }
+
+    void buildGraph(const std::vector<size_t>& due) {
+        const size_t n = due.size();
+        std::unordered_map<std::string, size_t> local;
+        for (size_t i = 0; i < n; ++i) local.emplace(m_systems[due[i]].desc.systemName, i);
+
+        // Explicit constraints first; they decide the order conflicting
+        // systems are serialized in.
+        std::vector<std::vector<size_t>> explicitEdges(n);
+        std::vector<size_t> inDegree(n, 0);
+        auto addExplicit = [&](size_t from, size_t to) {
+            explicitEdges[from].push_back(to);
+            ++inDegree[to];
+        };
+        for (size_t i = 0; i < n; ++i) {
+            const Entry& entry = m_systems[due[i]];
+            for (const std::string& other : entry.runBefore) {
+                if (auto it = local.find(other); it != local.end()) addExplicit(i, it->second);
+            }
+            for (const std::string& other : entry.runAfter) {
+                if (auto it = local.find(other); it != local.end()) addExplicit(it->second, i);
+            }
+        }
+
+        // Kahn's algorithm, lowest registration index first.
+        std::vector<size_t> order;
+        order.reserve(n);
+        std::vector<size_t> ready;
+        for (size_t i = 0; i < n; ++i) if (inDegree[i] == 0) ready.push_back(i);
+        while (!ready.empty()) {
+            auto lowest = std::min_element(ready.begin(), ready.end());
+            const size_t i = *lowest;
+            ready.erase(lowest);
+            order.push_back(i);
+            for (size_t to : explicitEdges[i]) {
+                if (--inDegree[to] == 0) ready.push_back(to);
+            }
+        }
+        if (order.size() != n) throw std::runtime_error("SystemScheduler: cyclic runBefore/runAfter constraints");
+
+        std::vector<size_t> rank(n);
+        for (size_t r = 0; r < n; ++r) rank[order[r]] = r;
+
+        m_nodes = std::vector<Node>(n);
+        for (size_t i = 0; i < n; ++i) m_nodes[i].system = due[i];
+        auto addEdge = [&](size_t from, size_t to) {
+            auto& succ = m_nodes[from].successors;
+            if (std::find(succ.begin(), succ.end(), to) != succ.end()) return;
+            succ.push_back(to);
+            ++m_nodes[to].dependencies;
+        };
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t to : explicitEdges[i]) addEdge(i, to);
+        }
+        for (size_t a = 0; a < n; ++a) {
+            for (size_t b = 0; b < n; ++b) {
+                if (rank[a] < rank[b] && conflicts(m_systems[due[a]], m_systems[due[b]])) addEdge(a, b);
+            }
+        }
+    }
+
+    void launch(size_t node, float dt, std::atomic<size_t>& remaining) {
+        m_pool.submit([this, node, dt, &remaining] {
+            const Entry& entry = m_systems[m_nodes[node].system];
+            entry.func(dt, entry.userData);
+            for (size_t next : m_nodes[node].successors) {
+                if (m_nodes[next].unmet.fetch_sub(1, std::memory_order_acq_rel) == 1) launch(next, dt, remaining);
+            }
+            remaining.fetch_sub(1, std::memory_order_acq_rel);
+        });
+    }
+
+    WorkStealingPool& m_pool;
+    std::vector<Entry> m_systems;
+    std::unordered_map<std::string, size_t> m_index;
+    std::vector<Node> m_nodes;
+    std::vector<size_t> m_due;
+    bool m_graphValid = false;
+};
@@ -0,0 +1,76 @@
+#pragma once
+#include <cstddef>
+#include <span>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Float column kernels for structure-of-arrays components.
+ * Uses AVX2 when the module is built with it (MODULE_ENABLE_AVX2), SSE2 on
+ * other x86-64 builds and a scalar loop everywhere else.
+ */
+namespace simd {
+
+#if defined(__AVX2__)
+inline constexpr size_t kFloatLanes = 8;
+#elif defined(__SSE2__) || defined(_M_X64)
+inline constexpr size_t kFloatLanes = 4;
+#else
+inline constexpr size_t kFloatLanes = 1;
+#endif
+
+// out[i] += value
+inline void addScalar(std::span<float> out, float value) {
+    float* p = out.data();
+    const size_t n = out.size();
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256 v = _mm256_set1_ps(value);
+    for (; i + 8 <= n; i += 8) _mm256_storeu_ps(p + i, _mm256_add_ps(_mm256_loadu_ps(p + i), v));
+#elif defined(__SSE2__) || defined(_M_X64)
+    const __m128 v = _mm_set1_ps(value);
+    for (; i + 4 <= n; i += 4) _mm_storeu_ps(p + i, _mm_add_ps(_mm_loadu_ps(p + i), v));
+#endif
+    for (; i < n; ++i) p[i] += value;
+}
+
+// out[i] *= value
+inline void scale(std::span<float> out, float value) {
+    float* p = out.data();
+    const size_t n = out.size();
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256 v = _mm256_set1_ps(value);
+    for (; i + 8 <= n; i += 8) _mm256_storeu_ps(p + i, _mm256_mul_ps(_mm256_loadu_ps(p + i), v));
+#elif defined(__SSE2__) || defined(_M_X64)
+    const __m128 v = _mm_set1_ps(value);
+    for (; i + 4 <= n; i += 4) _mm_storeu_ps(p + i, _mm_mul_ps(_mm_loadu_ps(p + i), v));
+#endif
+    for (; i < n; ++i) p[i] *= value;
+}
+
+// out[i] += in[i] * factor (e.g. position += velocity * dt)
+inline void addScaled(std::span<float> out, std::span<const float> in, float factor) {
+    float* p = out.data();
+    const float* q = in.data();
+    const size_t n = out.size() < in.size() ? out.size() : in.size();
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256 f = _mm256_set1_ps(factor);
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(p + i, _mm256_add_ps(_mm256_loadu_ps(p + i), _mm256_mul_ps(_mm256_loadu_ps(q + i), f)));
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    const __m128 f = _mm_set1_ps(factor);
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(p + i, _mm_add_ps(_mm_loadu_ps(p + i), _mm_mul_ps(_mm_loadu_ps(q + i), f)));
+    }
+#endif
+    for (; i < n; ++i) p[i] += q[i] * factor;
+}
+
+} // namespace simd
@@ -0,0 +1,36 @@
+#pragma once
+#include "Structs&Classes.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+/**
+ * @brief Layout fingerprint stored with each component in a snapshot.
+ *
+ * 64-bit FNV-1a over the component ID, sizeof/alignof T and, for SoA
+ * components, the field table. A change that keeps the size (reordering or
+ * retyping fields) is only caught through the field table; give T a
+ * `static constexpr uint32_t snapshotVersion` and bump it to invalidate
+ * older snapshots explicitly.
+ */
+template<typename T>
+uint64_t componentLayoutHash(uint32_t id, std::span<const FieldDesc> fields = {}) {
+    static_assert(std::is_trivially_copyable_v<T>, "snapshotted components are restored bytewise");
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            hash ^= (value >> (i * 8)) & 0xffu;
+            hash *= 1099511628211ull;
+        }
+    };
+    mix(id);
+    mix(sizeof(T));
+    mix(alignof(T));
+    for (const FieldDesc& field : fields) {
+        mix(field.offset);
+        mix(field.size);
+    }
+    if constexpr (requires { T::snapshotVersion; }) mix(T::snapshotVersion);
+    return hash;
+}
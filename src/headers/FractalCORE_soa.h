@@ -0,0 +1,104 @@
+#pragma once
+#include "Structs&Classes.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Field list of a component stored in structure-of-arrays mode.
+ * Specialize with FRACTAL_SOA_LAYOUT rather than by hand.
+ */
+template<typename T>
+struct SoALayout;
+
+#define FRACTAL_SOA_LAYOUT(Type, ...)                                        \
+    template<>                                                               \
+    struct SoALayout<Type> {                                                 \
+        static constexpr auto members = std::make_tuple(__VA_ARGS__);        \
+    }
+
+namespace soa_detail {
+
+template<typename M>
+struct MemberTraits;
+
+template<typename C, typename F>
+struct MemberTraits<F C::*> {
+    using Class = C;
+    using Field = F;
+};
+
+template<auto A, auto B>
+constexpr bool sameMember() {
+    if constexpr (std::is_same_v<decltype(A), decltype(B)>) return A == B;
+    else return false;
+}
+
+} // namespace soa_detail
+
+template<typename T>
+constexpr size_t soaFieldCount() {
+    return std::tuple_size_v<std::remove_const_t<decltype(SoALayout<T>::members)>>;
+}
+
+/**
+ * @brief Index of a member pointer inside SoALayout<T>::members.
+ */
+template<typename T, auto Member>
+constexpr size_t soaFieldIndex() {
+    constexpr auto& members = SoALayout<T>::members;
+    return []<size_t... I>(std::index_sequence<I...>) {
+        size_t index = sizeof...(I);
+        ((index = soa_detail::sameMember<std::get<I>(members), Member>() ? I : index), ...);
+        return index;
+    }(std::make_index_sequence<soaFieldCount<T>()>{});
+}
+
+/**
+ * @brief Builds the FieldDesc table passed to the core at registration.
+ */
+template<typename T>
+std::array<FieldDesc, soaFieldCount<T>()> soaFieldDescs() {
+    static_assert(std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>,
+                  "SoA components are scattered bytewise into columns");
+    const T probe{};
+    const auto* base = reinterpret_cast<const unsigned char*>(&probe);
+    return std::apply([&](auto... member) {
+        return std::array<FieldDesc, soaFieldCount<T>()>{ FieldDesc{
+            static_cast<size_t>(reinterpret_cast<const unsigned char*>(&(probe.*member)) - base),
+            sizeof(probe.*member) }... };
+    }, SoALayout<T>::members);
+}
+
+/**
+ * @brief Typed view of one chunk of a structure-of-arrays component.
+ */
+template<typename T>
+class SoAChunk {
+public:
+    SoAChunk(const Entity* entities, void* const* columns, size_t count)
+        : m_entities(entities), m_columns(columns), m_count(count) {}
+
+    size_t size() const { return m_count; }
+    std::span<const Entity> entities() const { return { m_entities, m_count }; }
+
+    /**
+     * @brief Column for a member, e.g. chunk.column<&PositionComponent::x>().
+     */
+    template<auto Member>
+    auto column() const {
+        using Field = typename soa_detail::MemberTraits<decltype(Member)>::Field;
+        constexpr size_t index = soaFieldIndex<T, Member>();
+        static_assert(index < soaFieldCount<T>(), "member is not part of SoALayout<T>");
+        return std::span<Field>(static_cast<Field*>(m_columns[index]), m_count);
+    }
+
+private:
+    const Entity* m_entities;
+    void* const* m_columns;
+    size_t m_count;
+};
@@ -0,0 +1,340 @@
+#pragma once
+#include "Structs&Classes.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+struct RadiusQuery {
+    float x;
+    float y;
+    float radius;
+};
+
+struct BoxQuery {
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+};
+
+/**
+ * @brief Results of a batched spatial query: one entity span per query,
+ * backed by a single buffer that is reused across batches.
+ */
+class SpatialQueryResults {
+public:
+    size_t size() const { return m_offsets.empty() ? 0 : m_offsets.size() - 1; }
+
+    std::span<const Entity> operator[](size_t query) const {
+        return { m_entities.data() + m_offsets[query], m_offsets[query + 1] - m_offsets[query] };
+    }
+
+    void clear() {
+        m_entities.clear();
+        m_offsets.assign(1, 0);
+    }
+
+    void push(Entity e) { m_entities.push_back(e); }
+    void endQuery() { m_offsets.push_back(m_entities.size()); }
+
+private:
+    std::vector<Entity> m_entities;
+    std::vector<size_t> m_offsets{ 0 };
+};
+
+/**
+ * @brief Uniform grid over a position-like component (any T with two float
+ * members, `x` and `y` by default). Cells are hashed into a power-of-two
+ * bucket table sized to the entity count, so the world needs no bounds.
+ *
+ * The grid holds a copy of every point sorted by bucket, so queries never
+ * touch component storage and stay valid until the next build. Building is
+ * beginBuild(), then buildChunk() for disjoint chunks of the dense range
+ * (safe to call concurrently), then endBuild(), which sorts the points into
+ * their buckets, serially or split into tasks. Queries are const and may run concurrently with each
+ * other; see ModuleAPI::registerSpatialIndex for per-frame maintenance.
+ */
+template<typename T>
+class SpatialGrid {
+public:
+    explicit SpatialGrid(float cellSize, float T::* x = &T::x, float T::* y = &T::y)
+        : m_cellSize(cellSize), m_invCell(1.0f / cellSize), m_x(x), m_y(y) {}
+
+    float cellSize() const { return m_cellSize; }
+    size_t size() const { return m_entities.size(); }
+
+    void clear() {
+        m_entities.clear();
+        m_xs.clear();
+        m_ys.clear();
+        m_bucketStart.assign(2, 0);
+        m_mask = 0;
+    }
+
+    // --- Building ---
+
+    /**
+     * @brief Starts a build over `count` components whose dense entity IDs
+     * start at `first`; chunks passed to buildChunk must point into it.
+     */
+    void beginBuild(const Entity* first, size_t count) {
+        size_t buckets = 64;
+        while (buckets < count) buckets *= 2;
+        m_mask = static_cast<uint32_t>(buckets - 1);
+        m_first = first;
+        m_keys.resize(count);
+        m_pointX.resize(count);
+        m_pointY.resize(count);
+    }
+
+    void buildChunk(std::span<const Entity> entities, std::span<const T> components) {
+        const size_t base = static_cast<size_t>(entities.data() - m_first);
+        for (size_t i = 0; i < components.size(); ++i) {
+            const float px = components[i].*m_x;
+            const float py = components[i].*m_y;
+            m_pointX[base + i] = px;
+            m_pointY[base + i] = py;
+            m_keys[base + i] = bucket(cell(px), cell(py));
+        }
+    }
+
+    // Counting sort of the points by bucket.
+    void endBuild() {
+        const size_t count = m_keys.size();
+        m_bucketStart.assign(size_t(m_mask) + 2, 0);
+        for (uint32_t key : m_keys) ++m_bucketStart[key + 1];
+        for (size_t b = 1; b < m_bucketStart.size(); ++b) m_bucketStart[b] += m_bucketStart[b - 1];
+
+        m_fill.assign(m_bucketStart.begin(), m_bucketStart.end() - 1);
+        m_entities.resize(count);
+        m_xs.resize(count);
+        m_ys.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            const uint32_t slot = m_fill[m_keys[i]]++;
+            m_entities[slot] = m_first[i];
+            m_xs[slot] = m_pointX[i];
+            m_ys[slot] = m_pointY[i];
+        }
+        m_first = nullptr;
+    }
+
+    /**
+     * @brief endBuild() split into `tasks` pieces of work. `forEach(tasks,
+     * body)` must call body(t) once for every t in [0, tasks), in any order
+     * and on any threads, and return when all calls have finished; it is
+     * called three times. The points are first scattered into up to 256
+     * partitions by the high bits of their bucket, then each partition is
+     * counting-sorted on its own. The result is identical to endBuild().
+     */
+    template<typename ForEach>
+    void endBuild(size_t tasks, ForEach&& forEach) {
+        const size_t count = m_keys.size();
+        tasks = std::min(tasks, count / kMinPointsPerTask);
+        if (tasks < 2) {
+            endBuild();
+            return;
+        }
+        const size_t buckets = size_t(m_mask) + 1;
+        const size_t partitions = std::min(kMaxPartitions, buckets);
+        const uint32_t shift = static_cast<uint32_t>(std::countr_zero(buckets / partitions));
+        auto blockBegin = [&](size_t t) { return count * t / tasks; };
+
+        // Per-task histograms over the partitions of their block.
+        m_blockCounts.assign(tasks * partitions, 0);
+        forEach(tasks, [&](size_t t) {
+            uint32_t* counts = m_blockCounts.data() + t * partitions;
+            for (size_t i = blockBegin(t); i < blockBegin(t + 1); ++i) ++counts[m_keys[i] >> shift];
+        });
+
+        // Turn them into scatter offsets, partition-major so each partition
+        // keeps dense order; remember where the partitions start.
+        m_partitionStart.resize(partitions + 1);
+        uint32_t offset = 0;
+        for (size_t p = 0; p < partitions; ++p) {
+            m_partitionStart[p] = offset;
+            for (size_t t = 0; t < tasks; ++t) {
+                const uint32_t n = m_blockCounts[t * partitions + p];
+                m_blockCounts[t * partitions + p] = offset;
+                offset += n;
+            }
+        }
+        m_partitionStart[partitions] = offset;
+
+        m_scatter.resize(count);
+        forEach(tasks, [&](size_t t) {
+            uint32_t* cursor = m_blockCounts.data() + t * partitions;
+            for (size_t i = blockBegin(t); i < blockBegin(t + 1); ++i) {
+                m_scatter[cursor[m_keys[i] >> shift]++] = { m_keys[i], m_first[i], m_pointX[i], m_pointY[i] };
+            }
+        });
+
+        // Each partition owns a disjoint run of buckets and output slots.
+        m_bucketStart.resize(buckets + 1);
+        m_bucketStart[0] = 0;
+        m_fill.resize(buckets);
+        m_entities.resize(count);
+        m_xs.resize(count);
+        m_ys.resize(count);
+        const size_t perPartition = buckets / partitions;
+        forEach(tasks, [&](size_t t) {
+            for (size_t p = partitions * t / tasks; p < partitions * (t + 1) / tasks; ++p) {
+                const size_t firstBucket = p * perPartition;
+                const uint32_t begin = m_partitionStart[p], end = m_partitionStart[p + 1];
+                uint32_t* fill = m_fill.data() + firstBucket;
+                std::fill_n(fill, perPartition, 0u);
+                for (uint32_t i = begin; i < end; ++i) ++fill[m_scatter[i].key - firstBucket];
+                uint32_t at = begin;
+                for (size_t b = 0; b < perPartition; ++b) {
+                    const uint32_t n = fill[b];
+                    fill[b] = at;
+                    at += n;
+                    m_bucketStart[firstBucket + b + 1] = at;
+                }
+                for (uint32_t i = begin; i < end; ++i) {
+                    const ScatteredPoint& point = m_scatter[i];
+                    const uint32_t slot = fill[point.key - firstBucket]++;
+                    m_entities[slot] = point.entity;
+                    m_xs[slot] = point.x;
+                    m_ys[slot] = point.y;
+                }
+            }
+        });
+        m_first = nullptr;
+    }
+
+    // --- Queries ---
+
+    /**
+     * @brief Calls f(Entity, x, y) for every point inside the box (edges
+     * included), each exactly once.
+     */
+    template<typename F>
+    void forEachInBox(const BoxQuery& box, F&& f) const {
+        if (m_entities.empty()) return;
+        const int32_t cx0 = cell(box.minX), cx1 = cell(box.maxX);
+        const int32_t cy0 = cell(box.minY), cy1 = cell(box.maxY);
+        if (cx1 < cx0 || cy1 < cy0) return;
+
+        auto inBox = [&](float px, float py) {
+            return px >= box.minX && px <= box.maxX && py >= box.minY && py <= box.maxY;
+        };
+        // Past one cell per bucket, scanning everything is cheaper.
+        const uint64_t cells = uint64_t(int64_t(cx1) - cx0 + 1) * uint64_t(int64_t(cy1) - cy0 + 1);
+        if (cells > uint64_t(m_mask) + 1) {
+            for (size_t s = 0; s < m_entities.size(); ++s) {
+                if (inBox(m_xs[s], m_ys[s])) f(m_entities[s], m_xs[s], m_ys[s]);
+            }
+            return;
+        }
+        for (int32_t cy = cy0; cy <= cy1; ++cy) {
+            for (int32_t cx = cx0; cx <= cx1; ++cx) {
+                const uint32_t b = bucket(cx, cy);
+                for (uint32_t s = m_bucketStart[b]; s < m_bucketStart[b + 1]; ++s) {
+                    const float px = m_xs[s], py = m_ys[s];
+                    // Other cells may share the bucket; report a point only from its own cell.
+                    if (inBox(px, py) && cell(px) == cx && cell(py) == cy) f(m_entities[s], px, py);
+                }
+            }
+        }
+    }
+
+    template<typename F>
+    void forEachInRadius(const RadiusQuery& query, F&& f) const {
+        const float r2 = query.radius * query.radius;
+        forEachInBox(BoxQuery{ query.x - query.radius, query.y - query.radius,
+                               query.x + query.radius, query.y + query.radius },
+                     [&](Entity e, float px, float py) {
+                         const float dx = px - query.x, dy = py - query.y;
+                         if (dx * dx + dy * dy <= r2) f(e, px, py);
+                     });
+    }
+
+    /**
+     * @brief Entities within `query.radius` of the query point; fills and
+     * returns a view of `out`.
+     */
+    std::span<const Entity> queryRadius(const RadiusQuery& query, std::vector<Entity>& out) const {
+        out.clear();
+        forEachInRadius(query, [&](Entity e, float, float) { out.push_back(e); });
+        return out;
+    }
+
+    std::span<const Entity> queryBox(const BoxQuery& box, std::vector<Entity>& out) const {
+        out.clear();
+        forEachInBox(box, [&](Entity e, float, float) { out.push_back(e); });
+        return out;
+    }
+
+    /**
+     * @brief Batched radius queries: results[i] holds the hits of queries[i].
+     * Split a large batch across chunks (one results object per chunk) to
+     * run it in parallel.
+     */
+    void queryRadius(std::span<const RadiusQuery> queries, SpatialQueryResults& results) const {
+        results.clear();
+        for (const RadiusQuery& query : queries) {
+            forEachInRadius(query, [&](Entity e, float, float) { results.push(e); });
+            results.endQuery();
+        }
+    }
+
+    void queryBox(std::span<const BoxQuery> queries, SpatialQueryResults& results) const {
+        results.clear();
+        for (const BoxQuery& box : queries) {
+            forEachInBox(box, [&](Entity e, float, float) { results.push(e); });
+            results.endQuery();
+        }
+    }
+
+private:
+    static constexpr size_t kMaxPartitions = 256;
+    // Below this many points per task, the serial sort wins.
+    static constexpr size_t kMinPointsPerTask = 16384;
+
+    struct ScatteredPoint {
+        uint32_t key;
+        Entity entity;
+        float x;
+        float y;
+    };
+
+    int32_t cell(float v) const {
+        constexpr float kLimit = 1073741824.0f; // 2^30, keeps cell ranges free of overflow
+        float c = std::floor(v * m_invCell);
+        if (!(c > -kLimit)) c = -kLimit; // also catches NaN
+        if (c > kLimit) c = kLimit;
+        return static_cast<int32_t>(c);
+    }
+
+    uint32_t bucket(int32_t cx, int32_t cy) const {
+        uint32_t h = static_cast<uint32_t>(cx) * 73856093u ^ static_cast<uint32_t>(cy) * 19349663u;
+        h ^= h >> 16;
+        return h & m_mask;
+    }
+
+    float m_cellSize;
+    float m_invCell;
+    float T::* m_x;
+    float T::* m_y;
+    uint32_t m_mask = 0;
+
+    // Sorted by bucket; bucket b owns [m_bucketStart[b], m_bucketStart[b + 1]).
+    std::vector<Entity> m_entities;
+    std::vector<float> m_xs;
+    std::vector<float> m_ys;
+    std::vector<uint32_t> m_bucketStart{ 0, 0 };
+
+    // Build scratch, in dense order; kept to avoid reallocating every frame.
+    const Entity* m_first = nullptr;
+    std::vector<uint32_t> m_keys;
+    std::vector<float> m_pointX;
+    std::vector<float> m_pointY;
+    std::vector<uint32_t> m_fill;
+    std::vector<uint32_t> m_blockCounts;
+    std::vector<uint32_t> m_partitionStart;
+    std::vector<ScatteredPoint> m_scatter;
+};
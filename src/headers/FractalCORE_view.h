@@ -0,0 +1,63 @@
+#pragma once
+#include "FractalCORE_handles.h"
+#include "Structs&Classes.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <type_traits>
+
+namespace view_detail {
+
+template<typename T, typename... Ts>
+constexpr bool isUnique = (!std::is_same_v<T, Ts> && ...) && isUnique<Ts...>;
+
+template<typename T>
+constexpr bool isUnique<T> = true;
+
+} // namespace view_detail
+
+/**
+ * @brief Handle to a registered group of components packed in lockstep.
+ * Index i of every member's dense storage belongs to the same entity for
+ * the whole group range, which is what GroupView relies on.
+ */
+template<typename... Ts>
+struct GroupHandle {
+    static_assert(sizeof...(Ts) > 0 && view_detail::isUnique<Ts...>, "group component types must be distinct");
+    std::array<uint32_t, sizeof...(Ts)> ids{};
+};
+
+/**
+ * @brief Typed view of one chunk of a group: parallel spans of entity IDs
+ * and of every member component. Access is plain pointer arithmetic, so it
+ * costs the same as hand-written index math.
+ */
+template<typename... Ts>
+class GroupView {
+public:
+    GroupView(const Entity* entities, std::tuple<Ts*...> columns, size_t count)
+        : m_entities(entities), m_columns(columns), m_count(count) {}
+
+    size_t size() const { return m_count; }
+    std::span<const Entity> entities() const { return { m_entities, m_count }; }
+
+    template<typename T>
+    std::span<T> get() const { return { std::get<T*>(m_columns), m_count }; }
+
+    /**
+     * @brief Calls f(Entity, Ts&...) for every entity of the chunk.
+     */
+    template<typename F>
+    void each(F&& f) const {
+        for (size_t i = 0; i < m_count; ++i) {
+            f(m_entities[i], std::get<Ts*>(m_columns)[i]...);
+        }
+    }
+
+private:
+    const Entity* m_entities;
+    std::tuple<Ts*...> m_columns;
+    size_t m_count;
+};
@@ -1,14 +1,42 @@
 #pragma once
 
 #include "FractalCORE_gateway.h"
+#include "FractalCORE_arena.h"
+#include "FractalCORE_budget.h"
+#include "FractalCORE_chunking.h"
+#include "FractalCORE_commands.h"
+#include "FractalCORE_events.h"
+#include "FractalCORE_handles.h"
+#include "FractalCORE_profiler.h"
+#include "FractalCORE_reduce.h"
+#include "FractalCORE_snapshot.h"
+#include "FractalCORE_soa.h"
+#include "FractalCORE_spatial.h"
+#include "FractalCORE_view.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <deque>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <type_traits>
+#include <tuple>
 #include <unordered_map>
+#include <utility>
 #include <string>
 #include <functional>
 #include <stdexcept>
 #include <vector>
 
+// Chunk callbacks hand out ComponentData::dense directly as Entity IDs.
+static_assert(sizeof(Entity) == sizeof(uint32_t) && std::is_standard_layout_v<Entity>,
+              "Entity must stay layout-compatible with ComponentData::dense");
+
 /**
  * @brief Context holder for ABI-stable event dispatching.
  */
@@ -17,43 +45,895 @@ struct EventContext {
     void (*originalHandler)(const T&, void*);
     void* originalUserData;
     uint32_t eventID;
+    const char* profileName = nullptr; // only set when FRACTAL_PROFILING is on
+};
+
+/**
+ * @brief Position in a component's change history. Passes that take a
+ * cursor visit what changed since the cursor's previous use and advance it;
+ * a fresh cursor sees everything once.
+ */
+struct ChangeCursor {
+    uint64_t tick = 0;
+};
+
+/**
+ * @brief Module-side batch channel for one event type: the ring that
+ * producers write into and the span handlers drained once per frame.
+ */
+struct EventChannelBase {
+    virtual ~EventChannelBase() = default;
+    virtual void flush() = 0;
+};
+
+template<typename T>
+struct EventChannel : EventChannelBase {
+    struct BatchHandler {
+        void (*handler)(std::span<const T>, void*);
+        void* userData;
+    };
+
+    EventStream<T> stream;
+    std::vector<BatchHandler> handlers;
+    const char* profileName = nullptr; // only set when FRACTAL_PROFILING is on
+    const char* latencyName = nullptr; // likewise
+
+    // Gateway events that found the ring full. They are delivered after the
+    // ring's events on the next flush, so nothing forwarded is lost.
+    std::mutex overflowMutex;
+    std::vector<T> overflow;
+    std::vector<T> overflowBatch; // consumer side, swapped with `overflow`
+    std::atomic<uint64_t> overflowed{ 0 };
+
+    explicit EventChannel(size_t capacity) : stream(capacity) {}
+
+    void forward(const T& event) {
+        if (stream.emplace(event)) return;
+        overflowed.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(overflowMutex);
+        overflow.push_back(event);
+    }
+
+    void flush() override {
+        auto deliver = [this](std::span<const T> events) {
+            FRACTAL_PROFILE_SCOPE(profileName, Event, events.size());
+            for (const BatchHandler& h : handlers) h.handler(events, h.userData);
+        };
+#if FRACTAL_PROFILING
+        // Queue latency: from the oldest event's reserve() to its dispatch.
+        const uint64_t dispatchNs = Profiler::instance().nowNs();
+        const size_t drained = stream.drain(deliver);
+        const uint64_t queuedNs = stream.takeOldestNs();
+        if (drained && queuedNs && queuedNs < dispatchNs) {
+            Profiler::instance().record(latencyName, ProfileCategory::Event, queuedNs, dispatchNs, drained);
+        }
+#else
+        stream.drain(deliver);
+#endif
+        {
+            std::lock_guard<std::mutex> lock(overflowMutex);
+            overflowBatch.swap(overflow);
+        }
+        if (overflowBatch.empty()) return;
+        deliver(overflowBatch);
+        overflowBatch.clear();
+    }
 };
 
 /**
  * @brief High-level C++ Wrapper for the FractalCORE Gateway API.
  * Provides a type-safe interface for ECS, Task Scheduling, and Event systems.
+ * Contexts behind registered systems and subscriptions are owned by the API
+ * and freed when it is destroyed, so destroy it in onUnload.
  */
 class ModuleAPI {
 private:
+    using RawChunkFunc = void (*)(const Entity*, void*, size_t, void*);
+    using ReadChunkFunc = void (*)(const Entity*, const void*, size_t, void*);
+
+    // The core's gateway, copied up to the size the core reported and
+    // null-padded past it, so checking an entry for null is always safe.
+    FractalCORE_Gateway m_table{};
     FractalCORE_Gateway* m_gw;
-    std::unordered_map<std::string, uint32_t> m_eventIDCache;
+    // Names of the components registered through this API, the only way to
+    // reach them on cores without the *ById entries.
+    std::unordered_map<uint32_t, std::string> m_componentNames;
+    // Events used by this API by name hash: the core's ID (the hash itself
+    // unless the core is legacy and assigns its own) and the name, which
+    // catches a second name hashing to the same value.
+    struct CachedEvent {
+        uint32_t id;
+        std::string name;
+    };
+    std::unordered_map<uint32_t, CachedEvent> m_eventIDCache;
+    std::unordered_map<uint32_t, std::unique_ptr<EventChannelBase>> m_eventChannels;
+    // Passes may start from concurrently running systems.
+    mutable std::mutex m_tunerMutex;
+    std::unordered_map<uint64_t, std::unique_ptr<ChunkTuner>> m_chunkTuners;
+    std::chrono::nanoseconds m_autoChunkTarget = std::chrono::microseconds(50);
+    // Trampoline contexts handed to the core; freed together with the API.
+    ContextArena m_contexts;
+    // Components covered by saveSnapshot/loadSnapshot.
+    std::vector<SnapshotLayout> m_snapshotLayouts;
+    // Cursors of Budgeted systems, owned by their contexts in m_contexts.
+    std::vector<const BudgetedCursor*> m_budgetedSystems;
+
+#if FRACTAL_PROFILING
+    // A profiled InlineTask does not fit in another task's buffer, so it
+    // waits in a node while queued and the core only sees the node. Nodes
+    // of one-shot tasks are recycled once they ran; tick task nodes live as
+    // long as the API.
+    struct ProfiledTaskNode {
+        InlineTask inner;
+        const char* name = nullptr;
+        bool once = true;
+        ProfiledTaskNode* next = nullptr;
+    };
+    std::mutex m_taskNodeMutex;
+    std::deque<ProfiledTaskNode> m_taskNodes;
+    ProfiledTaskNode* m_freeTaskNodes = nullptr;
+
+    InlineTask profiledTask(InlineTask task, const char* name, bool once = true) {
+        ProfiledTaskNode* node;
+        {
+            std::lock_guard<std::mutex> lock(m_taskNodeMutex);
+            if (m_freeTaskNodes) {
+                node = m_freeTaskNodes;
+                m_freeTaskNodes = node->next;
+            } else {
+                node = &m_taskNodes.emplace_back();
+            }
+        }
+        node->inner = std::move(task);
+        node->name = name;
+        node->once = once;
+        // Trivially copyable, so the core never calls back into the module
+        // to move or destroy it.
+        struct Run {
+            ModuleAPI* api;
+            ProfiledTaskNode* node;
+            void operator()() const {
+                {
+                    FRACTAL_PROFILE_SCOPE(node->name, Task, 0);
+                    node->inner();
+                }
+                if (node->once) api->releaseTaskNode(node);
+            }
+        };
+        return InlineTask(Run{ this, node });
+    }
+
+    void releaseTaskNode(ProfiledTaskNode* node) {
+        node->inner.reset();
+        std::lock_guard<std::mutex> lock(m_taskNodeMutex);
+        node->next = m_freeTaskNodes;
+        m_freeTaskNodes = node;
+    }
+#endif
+
+    // What a ChunkTuner is measuring; part of its registry key.
+    enum class TunedPass : uint8_t {
+        Entities,
+        Chunks,
+        Columns,
+        Group,
+        System,
+        Changed,
+        Reduce,
+        Read
+    };
+
+    /**
+     * @brief Persistent tuner for an auto-sized pass, created on first use.
+     * `label` is only evaluated on creation.
+     */
+    template<typename Label>
+    ChunkTuner* chunkTuner(TunedPass pass, uint32_t id, Label&& label) {
+        const uint64_t key = (uint64_t(id) << 8) | uint64_t(pass);
+        std::lock_guard<std::mutex> lock(m_tunerMutex);
+        auto it = m_chunkTuners.find(key);
+        if (it == m_chunkTuners.end()) {
+            const size_t workers = m_gw->workerCount ? m_gw->workerCount(m_gw->api)
+                                                     : std::thread::hardware_concurrency();
+            it = m_chunkTuners.emplace(key, std::make_unique<ChunkTuner>(label(), m_autoChunkTarget, 256, workers)).first;
+        }
+        return it->second.get();
+    }
+
+    // Registered name of a component for tuner labels and default system
+    // names; components registered elsewhere fall back to their ID.
+    std::string componentLabel(uint32_t id) const {
+        const std::string* name = componentName(id);
+        return name ? *name : "component#" + std::to_string(id);
+    }
+
+    template<size_t N>
+    std::string groupLabel(const std::array<uint32_t, N>& ids) const {
+        std::string label;
+        for (uint32_t id : ids) label += (label.empty() ? "" : "+") + componentLabel(id);
+        return label;
+    }
+
+#if FRACTAL_PROFILING
+    enum class ProfiledPass : uint8_t {
+        Chunks,
+        Columns,
+        Changed,
+        Read,
+        Range
+    };
+
+    /**
+     * @brief Interned profiler name of a pass over a component. Cached per
+     * thread, so a warm dispatch neither builds a string nor takes the
+     * profiler's intern lock.
+     */
+    static const char* passProfileName(uint32_t id, const std::string* name, ProfiledPass pass) {
+        thread_local std::unordered_map<uint64_t, const char*> names;
+        const uint64_t key = (uint64_t(id) << 8) | uint64_t(pass);
+        auto it = names.find(key);
+        if (it != names.end()) return it->second;
+
+        static constexpr const char* kSuffix[] = { "", "/columns", "/changed", "/read", "/range" };
+        std::string label = (name ? *name : "component#" + std::to_string(id)) + kSuffix[size_t(pass)];
+        return names.emplace(key, Profiler::instance().intern(label)).first->second;
+    }
+#endif
+
+    /**
+     * @brief Runs a raw chunk callback over the packed range of a component.
+     * Falls back to a serial walk of getComponentData() on cores without
+     * updateParallelChunks.
+     */
+    static void dispatchChunks(FractalCORE_Gateway* gw, const std::string& name,
+                               RawChunkFunc func, void* userCtx, size_t chunkSize,
+                               ChunkTuner* tuner = nullptr) {
+        if (tuner) {
+            chunking_detail::TimedChunks<const Entity*, void*, size_t> timed{ func, userCtx, tuner };
+            dispatchChunks(gw, name, &decltype(timed)::invoke, &timed, tuner->chunkSize());
+            tuner->endPass();
+            return;
+        }
+#if FRACTAL_PROFILING
+        chunking_detail::ProfiledChunks<const Entity*, void*, size_t> profiled{
+            func, userCtx, passProfileName(hashName(name), &name, ProfiledPass::Chunks) };
+        func = &decltype(profiled)::invoke;
+        userCtx = &profiled;
+#endif
+        if (gw->updateParallelChunks) {
+            gw->updateParallelChunks(gw->api, name, func, userCtx, chunkSize);
+            return;
+        }
+        ComponentData* cd = gw->getComponentData ? gw->getComponentData(gw->api, name) : nullptr;
+        if (!cd) return;
+        requireRows(cd, name, "a chunk pass");
+        if (!cd->data) return;
+
+        const size_t count = cd->dense.size();
+        const size_t step = chunkSize ? chunkSize : count;
+        auto* bytes = static_cast<uint8_t*>(cd->data);
+        for (size_t start = 0; start < count; start += step) {
+            const size_t n = std::min(step, count - start);
+            func(reinterpret_cast<const Entity*>(cd->dense.data() + start),
+                 bytes + start * cd->elementSize, n, userCtx);
+        }
+    }
+
+    /**
+     * @brief Runs a typed SoA chunk callback over a component's columns.
+     * On cores without column storage the component lives as plain structs;
+     * each chunk is then transposed into thread-local columns and back.
+     */
+    template<typename T>
+    static void dispatchColumns(FractalCORE_Gateway* gw, uint32_t id, const std::string* name,
+                                void (*func)(const Entity*, void* const*, size_t, void*),
+                                void* userCtx, size_t chunkSize, ChunkTuner* tuner = nullptr) {
+        if (tuner) {
+            chunking_detail::TimedChunks<const Entity*, void* const*, size_t> timed{ func, userCtx, tuner };
+            dispatchColumns<T>(gw, id, name, &decltype(timed)::invoke, &timed, tuner->chunkSize());
+            tuner->endPass();
+            return;
+        }
+        // Keep chunk starts on SIMD-width boundaries so columns stay aligned.
+        if (chunkSize < SIZE_MAX - 7) chunkSize = (std::max<size_t>(chunkSize, 8) + 7) & ~size_t(7);
+        if (gw->updateParallelColumnsById) {
+#if FRACTAL_PROFILING
+            chunking_detail::ProfiledChunks<const Entity*, void* const*, size_t> profiled{
+                func, userCtx, passProfileName(id, name, ProfiledPass::Columns) };
+            func = &decltype(profiled)::invoke;
+            userCtx = &profiled;
+#endif
+            gw->updateParallelColumnsById(gw->api, id, func, userCtx, chunkSize);
+            return;
+        }
+        struct TransposeCtx {
+            void (*f)(const Entity*, void* const*, size_t, void*);
+            void* user;
+        };
+        TransposeCtx ctx{ func, userCtx };
+
+        auto transpose_func = [](const Entity* entities, void* data, size_t count, void* userCtx) {
+            static const auto fields = soaFieldDescs<T>();
+            thread_local std::vector<unsigned char> scratch;
+            auto* tCtx = static_cast<TransposeCtx*>(userCtx);
+            auto* rows = static_cast<unsigned char*>(data);
 
+            scratch.resize(sizeof(T) * count);
+            void* columns[soaFieldCount<T>()];
+            size_t offset = 0;
+            for (size_t f = 0; f < fields.size(); ++f) {
+                columns[f] = scratch.data() + offset;
+                for (size_t i = 0; i < count; ++i) {
+                    std::memcpy(scratch.data() + offset + i * fields[f].size,
+                                rows + i * sizeof(T) + fields[f].offset, fields[f].size);
+                }
+                offset += fields[f].size * count;
+            }
+
+            tCtx->f(entities, columns, count, tCtx->user);
+
+            for (size_t f = 0; f < fields.size(); ++f) {
+                for (size_t i = 0; i < count; ++i) {
+                    std::memcpy(rows + i * sizeof(T) + fields[f].offset,
+                                static_cast<unsigned char*>(columns[f]) + i * fields[f].size, fields[f].size);
+                }
+            }
+        };
+        if (gw->updateParallelChunksById) {
+            gw->updateParallelChunksById(gw->api, id, transpose_func, &ctx, chunkSize);
+        } else if (name) {
+            dispatchChunks(gw, *name, transpose_func, &ctx, chunkSize);
+        } else {
+            throw std::runtime_error("ModuleAPI: component was not registered through this module");
+        }
+    }
+
+    /**
+     * @brief Runs a raw chunk callback over the chunks of a component that
+     * changed since `cursor`. Cores without change tracking visit everything.
+     */
+    static void dispatchChanged(FractalCORE_Gateway* gw, uint32_t id, const std::string* name, ChangeCursor& cursor,
+                                RawChunkFunc func, void* userCtx, size_t chunkSize, ChunkTuner* tuner = nullptr) {
+        if (tuner) {
+            chunking_detail::TimedChunks<const Entity*, void*, size_t> timed{ func, userCtx, tuner };
+            dispatchChanged(gw, id, name, cursor, &decltype(timed)::invoke, &timed, tuner->chunkSize());
+            tuner->endPass();
+            return;
+        }
+        if (gw->updateParallelChangedById) {
+#if FRACTAL_PROFILING
+            chunking_detail::ProfiledChunks<const Entity*, void*, size_t> profiled{
+                func, userCtx, passProfileName(id, name, ProfiledPass::Changed) };
+            func = &decltype(profiled)::invoke;
+            userCtx = &profiled;
+#endif
+            gw->updateParallelChangedById(gw->api, id, &cursor.tick, func, userCtx, chunkSize);
+        } else if (gw->updateParallelChunksById) {
+            gw->updateParallelChunksById(gw->api, id, func, userCtx, chunkSize);
+        } else if (name) {
+            dispatchChunks(gw, *name, func, userCtx, chunkSize);
+        } else {
+            throw std::runtime_error("ModuleAPI: component was not registered through this module");
+        }
+    }
+
+    // Components the core keeps as columns have no element array, so paths
+    // that point into one must refuse them rather than skip them.
+    static void requireRows(const ComponentData* cd, const std::string& label, const char* what) {
+        if (cd && !cd->data && !cd->dense.empty()) {
+            throw std::logic_error(std::string("ModuleAPI: ") + what + " needs '" + label +
+                                   "' stored as plain structs, but the core keeps it as columns");
+        }
+    }
+
+    void requireRows(const ComponentData* cd, uint32_t id, const char* what) const {
+        const std::string* name = componentName(id);
+        requireRows(cd, name ? *name : "component#" + std::to_string(id), what);
+    }
+
+    // Runs on every emit by name, so the cached case must not allocate.
     uint32_t getEventId(const std::string& name) {
-        auto it = m_eventIDCache.find(name);
-        if (it != m_eventIDCache.end()) return it->second;
-        
-        uint32_t id = m_gw->registerEvent(m_gw->api, name);
-        m_eventIDCache[name] = id;
+        const uint32_t hash = hashName(name);
+        auto it = m_eventIDCache.find(hash);
+        if (it != m_eventIDCache.end()) {
+            if (it->second.name != name) {
+                throw std::runtime_error("ModuleAPI: event ID collision between '" + it->second.name + "' and '" + name + "'");
+            }
+            return it->second.id;
+        }
+
+        uint32_t id = hash;
+        if (m_gw->registerEventById) {
+            if (!m_gw->registerEventById(m_gw->api, hash, name.c_str())) {
+                throw std::runtime_error("ModuleAPI: event ID collision for '" + name + "'");
+            }
+        } else {
+            id = m_gw->registerEvent(m_gw->api, name);
+        }
+        m_eventIDCache.emplace(hash, CachedEvent{ id, name });
         return id;
     }
 
+    // Handles carry the name hash; only legacy cores need it translated.
+    uint32_t resolveEventId(uint32_t hash) const {
+        if (m_gw->registerEventById) return hash;
+        auto it = m_eventIDCache.find(hash);
+        if (it == m_eventIDCache.end()) throw std::runtime_error("ModuleAPI: event handle was never registered");
+        return it->second.id;
+    }
+
+    template<typename T>
+    EventChannel<T>& eventChannel(EventHandle<T> handle, size_t capacity = 4096) {
+        auto it = m_eventChannels.find(handle.id);
+        if (it != m_eventChannels.end()) return static_cast<EventChannel<T>&>(*it->second);
+
+        auto* channel = new EventChannel<T>(capacity);
+#if FRACTAL_PROFILING
+        channel->profileName = Profiler::instance().intern("event#" + std::to_string(handle.id) + "/batch");
+        channel->latencyName = Profiler::instance().intern("event#" + std::to_string(handle.id) + "/latency");
+#endif
+        m_eventChannels.emplace(handle.id, std::unique_ptr<EventChannelBase>(channel));
+
+        // Forward events that arrive through the gateway into the ring.
+        subscribe<T>(handle, [](const T& event, void* userData) {
+            static_cast<EventChannel<T>*>(userData)->forward(event);
+        }, channel);
+
+        // Drain once per frame.
+        std::string systemName = "Event_" + std::to_string(handle.id) + "_BatchFlush";
+        registerSystemTrampoline(systemName, [](float, void* userData) {
+            static_cast<EventChannelBase*>(userData)->flush();
+        }, static_cast<void*>(channel));
+
+        SystemConfig desc;
+        desc.systemName = systemName;
+        desc.trigger = TriggerType::Always;
+        desc.enabled = true;
+        registerInLoop(desc);
+
+        return *channel;
+    }
+
+    // Hands a system's loop settings to the core: the SystemDesc part through
+    // registerSystemInLoop, access and ordering through registerSystemAccess
+    // on cores that schedule concurrently.
+    void registerInLoop(const SystemConfig& config) {
+        if (m_gw->registerSystemAccess) {
+            std::vector<const char*> before, after;
+            for (const std::string& name : config.runBefore) before.push_back(name.c_str());
+            for (const std::string& name : config.runAfter) after.push_back(name.c_str());
+            const SystemAccess access{ config.reads.data(), config.reads.size(), config.writes.data(), config.writes.size(),
+                                       before.data(), before.size(), after.data(), after.size() };
+            m_gw->registerSystemAccess(m_gw->api, config.systemName.c_str(), &access);
+        }
+        SystemDesc desc = config;
+        m_gw->registerSystemInLoop(m_gw->api, desc);
+    }
+
+    // Hands a system trampoline to the core; with profiling on it is wrapped
+    // so every run is recorded under the system's name.
+    void registerSystemTrampoline(const std::string& systemName, void (*func)(float, void*), void* userData) {
+#if FRACTAL_PROFILING
+        struct ProfiledSystem {
+            void (*inner)(float, void*);
+            void* innerData;
+            const char* name;
+        };
+        auto* profiled = m_contexts.make<ProfiledSystem>(func, userData, Profiler::instance().intern(systemName));
+        func = [](float dt, void* data) {
+            auto* system = static_cast<ProfiledSystem*>(data);
+            FRACTAL_PROFILE_SCOPE(system->name, System, 0);
+            system->inner(dt, system->innerData);
+        };
+        userData = profiled;
+#endif
+        m_gw->registerSystem(m_gw->api, systemName, func, userData);
+    }
+
+    template<typename T>
+    void trackSnapshotLayout(uint32_t id, std::span<const FieldDesc> fields = {}) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            for (const SnapshotLayout& layout : m_snapshotLayouts) {
+                if (layout.id == id) return;
+            }
+            m_snapshotLayouts.push_back(SnapshotLayout{ id, sizeof(T), componentLayoutHash<T>(id, fields) });
+        }
+    }
+
+    const std::string* componentName(uint32_t id) const {
+        auto it = m_componentNames.find(id);
+        return it != m_componentNames.end() ? &it->second : nullptr;
+    }
+
+    // Name for the entries that only take names; throws for components not
+    // registered through this module.
+    const std::string& legacyComponentName(uint32_t id) const {
+        const std::string* name = componentName(id);
+        if (!name) throw std::runtime_error("ModuleAPI: component was not registered through this module");
+        return *name;
+    }
+
+    // Without either chunk entry the core only offers the per-entity
+    // updateParallel.
+    bool hasChunkPasses() const {
+        return m_gw->updateParallelChunksById || m_gw->updateParallelChunks;
+    }
+
+    ComponentData* componentDataById(uint32_t id) {
+        if (m_gw->getComponentDataById) return m_gw->getComponentDataById(m_gw->api, id);
+        const std::string* name = componentName(id);
+        return (name && m_gw->getComponentData) ? m_gw->getComponentData(m_gw->api, *name) : nullptr;
+    }
+
+    // The bulk entries take entity arrays; ranges are expanded into a
+    // per-thread buffer that keeps its capacity between calls.
+    static std::span<const Entity> expandRange(EntityRange range) {
+        thread_local std::vector<Entity> ids;
+        ids.resize(range.size());
+        for (size_t i = 0; i < ids.size(); ++i) ids[i] = range[i];
+        return ids;
+    }
+
+    // Untyped bulk paths used by command playback; elements are `size` bytes each.
+    void attachComponentsRaw(uint32_t id, const std::vector<Entity>& entities, const std::byte* data, size_t size) {
+        if (m_gw->attachComponentsById) {
+            m_gw->attachComponentsById(m_gw->api, id, entities.data(), data, entities.size());
+            return;
+        }
+        for (size_t i = 0; i < entities.size(); ++i) {
+            void* element = const_cast<std::byte*>(data + i * size);
+            if (m_gw->attachComponentById) {
+                m_gw->attachComponentById(m_gw->api, entities[i], id, element);
+            } else if (const std::string* name = componentName(id); name && m_gw->attachComponent) {
+                m_gw->attachComponent(m_gw->api, entities[i], *name, element);
+            }
+        }
+    }
+
+    void removeComponentsRaw(uint32_t id, const std::vector<Entity>& entities) {
+        if (m_gw->removeComponentsById) {
+            m_gw->removeComponentsById(m_gw->api, id, entities.data(), entities.size());
+            return;
+        }
+        for (Entity e : entities) {
+            if (m_gw->removeComponentById) {
+                m_gw->removeComponentById(m_gw->api, e, id);
+            } else if (const std::string* name = componentName(id); name && m_gw->removeComponent) {
+                m_gw->removeComponent(m_gw->api, e, *name);
+            }
+        }
+    }
+
+    void dispatchChunks(uint32_t id, RawChunkFunc func, void* userCtx, size_t chunkSize,
+                        ChunkTuner* tuner = nullptr) {
+        if (tuner) {
+            chunking_detail::TimedChunks<const Entity*, void*, size_t> timed{ func, userCtx, tuner };
+            dispatchChunks(id, &decltype(timed)::invoke, &timed, tuner->chunkSize());
+            tuner->endPass();
+            return;
+        }
+        if (m_gw->updateParallelChunksById) {
+#if FRACTAL_PROFILING
+            chunking_detail::ProfiledChunks<const Entity*, void*, size_t> profiled{
+                func, userCtx, passProfileName(id, componentName(id), ProfiledPass::Chunks) };
+            func = &decltype(profiled)::invoke;
+            userCtx = &profiled;
+#endif
+            m_gw->updateParallelChunksById(m_gw->api, id, func, userCtx, chunkSize);
+        } else {
+            dispatchChunks(m_gw, legacyComponentName(id), func, userCtx, chunkSize);
+        }
+    }
+
+    /**
+     * @brief Runs a read-only chunk callback over a component. Cores without
+     * readParallelChunksById run the mutable pass instead, which stamps
+     * every block as changed.
+     */
+    void dispatchRead(uint32_t id, ReadChunkFunc func, void* userCtx, size_t chunkSize,
+                      ChunkTuner* tuner = nullptr) {
+        if (tuner) {
+            chunking_detail::TimedChunks<const Entity*, const void*, size_t> timed{ func, userCtx, tuner };
+            dispatchRead(id, &decltype(timed)::invoke, &timed, tuner->chunkSize());
+            tuner->endPass();
+            return;
+        }
+        if (!m_gw->readParallelChunksById) {
+            struct MutableCtx {
+                ReadChunkFunc f;
+                void* user;
+            };
+            MutableCtx ctx{ func, userCtx };
+            auto mutable_func = [](const Entity* entities, void* data, size_t count, void* userCtx) {
+                auto* mCtx = static_cast<MutableCtx*>(userCtx);
+                mCtx->f(entities, data, count, mCtx->user);
+            };
+            dispatchChunks(id, mutable_func, &ctx, chunkSize);
+            return;
+        }
+#if FRACTAL_PROFILING
+        chunking_detail::ProfiledChunks<const Entity*, const void*, size_t> profiled{
+            func, userCtx, passProfileName(id, componentName(id), ProfiledPass::Read) };
+        func = &decltype(profiled)::invoke;
+        userCtx = &profiled;
+#endif
+        m_gw->readParallelChunksById(m_gw->api, id, func, userCtx, chunkSize);
+    }
+
+    /**
+     * @brief Runs a raw chunk callback over dense elements [begin, end) of a
+     * component. Falls back to a serial walk of the component's storage on
+     * cores without updateParallelRangeById.
+     */
+    void dispatchRange(uint32_t id, size_t begin, size_t end, RawChunkFunc func, void* userCtx, size_t chunkSize,
+                       ChunkTuner* tuner = nullptr) {
+        if (tuner) {
+            chunking_detail::TimedChunks<const Entity*, void*, size_t> timed{ func, userCtx, tuner };
+            dispatchRange(id, begin, end, &decltype(timed)::invoke, &timed, tuner->chunkSize());
+            tuner->endPass();
+            return;
+        }
+        if (m_gw->updateParallelRangeById) {
+#if FRACTAL_PROFILING
+            chunking_detail::ProfiledChunks<const Entity*, void*, size_t> profiled{
+                func, userCtx, passProfileName(id, componentName(id), ProfiledPass::Range) };
+            func = &decltype(profiled)::invoke;
+            userCtx = &profiled;
+#endif
+            m_gw->updateParallelRangeById(m_gw->api, id, begin, end, func, userCtx, chunkSize);
+            return;
+        }
+        ComponentData* cd = componentDataById(id);
+        if (!cd) return;
+        requireRows(cd, id, "a range pass");
+        if (!cd->data) return;
+        end = std::min(end, cd->dense.size());
+        const size_t step = chunkSize ? chunkSize : end - std::min(begin, end);
+        auto* bytes = static_cast<uint8_t*>(cd->data);
+        for (size_t start = begin; start < end; start += step) {
+            const size_t n = std::min(step, end - start);
+            func(reinterpret_cast<const Entity*>(cd->dense.data() + start), bytes + start * cd->elementSize, n, userCtx);
+        }
+    }
+
+    template<typename... Ts>
+    struct GroupViewCtx {
+        void (*f)(GroupView<Ts...>, void*);
+        void* user;
+        std::tuple<Ts*...> columns;
+        const uint32_t* dense;
+    };
+
+    template<typename... Ts>
+    static GroupView<Ts...> groupChunk(const GroupViewCtx<Ts...>& ctx, size_t start, size_t end) {
+        auto columns = std::apply([start](Ts*... base) { return std::tuple<Ts*...>(base + start...); }, ctx.columns);
+        return GroupView<Ts...>(reinterpret_cast<const Entity*>(ctx.dense) + start, columns, end - start);
+    }
+
+    template<typename... Ts>
+    static void groupViewTrampoline(size_t start, size_t end, void* userCtx) {
+        auto* ctx = static_cast<GroupViewCtx<Ts...>*>(userCtx);
+        ctx->f(groupChunk(*ctx, start, end), ctx->user);
+    }
+
+    // Resolves each member's storage once per call; the dense IDs of the first
+    // member double as the group's entity IDs. False when a member is missing
+    // or has never held an element, i.e. the group is empty.
+    template<typename... Ts>
+    bool bindGroupColumns(GroupViewCtx<Ts...>& ctx, const std::array<ComponentData*, sizeof...(Ts)>& data,
+                          const std::array<uint32_t, sizeof...(Ts)>& ids) const {
+        for (size_t i = 0; i < data.size(); ++i) requireRows(data[i], ids[i], "a group view");
+        for (ComponentData* cd : data) {
+            if (!cd || !cd->data) return false;
+        }
+        ctx.columns = [&]<size_t... I>(std::index_sequence<I...>) {
+            return std::tuple<Ts*...>{ static_cast<Ts*>(data[I]->data)... };
+        }(std::index_sequence_for<Ts...>{});
+        ctx.dense = data[0]->dense.data();
+        return true;
+    }
+
+    template<typename... Ts>
+    std::vector<std::string> groupNames(const GroupHandle<Ts...>& group) const {
+        std::vector<std::string> names;
+        for (uint32_t id : group.ids) {
+            const std::string* name = componentName(id);
+            if (!name) throw std::runtime_error("ModuleAPI: group member was not registered through this module");
+            names.push_back(*name);
+        }
+        return names;
+    }
+
 public:
-    explicit ModuleAPI(FractalCORE_Gateway* gateway) : m_gw(gateway) {
-        if (!m_gw) throw std::invalid_argument("ModuleAPI: Gateway pointer cannot be null");
+    explicit ModuleAPI(FractalCORE_Gateway* gateway) : m_gw(&m_table) {
+        if (!gateway) throw std::invalid_argument("ModuleAPI: Gateway pointer cannot be null");
+        size_t size = offsetof(FractalCORE_Gateway, abiMagic);
+        if (gateway->abiMagic == kGatewayAbiMagic) {
+            size = std::clamp<size_t>(gateway->structSize, size, sizeof(FractalCORE_Gateway));
+        }
+        std::memcpy(&m_table, gateway, size);
     }
 
+    // m_gw points into the object itself.
+    ModuleAPI(const ModuleAPI&) = delete;
+    ModuleAPI& operator=(const ModuleAPI&) = delete;
+
     // --- Core Management ---
 
     Entity createEntity() {
         return (m_gw && m_gw->createEntity) ? m_gw->createEntity(m_gw->api) : Entity{0};
     }
     
+    /**
+     * @brief Creates `count` entities with consecutive IDs.
+     */
+    EntityRange createEntities(size_t count) {
+        if (count == 0) return EntityRange{};
+        if (m_gw->createEntities) return EntityRange{ m_gw->createEntities(m_gw->api, count), count };
+
+        // Older cores hand out IDs one by one; they are sequential in practice,
+        // but the range is only valid if that actually held.
+        EntityRange range{ createEntity(), count };
+        for (size_t i = 1; i < count; ++i) {
+            if (createEntity().id != range[i].id) {
+                throw std::runtime_error("ModuleAPI: core allocated non-contiguous entity IDs");
+            }
+        }
+        return range;
+    }
+
+    /**
+     * @brief Removes all components of `e` and recycles its ID slot. Handles
+     * still holding `e` become stale: getComponent/hasComponent miss and
+     * attachComponent is ignored for them.
+     */
+    void destroyEntity(Entity e) {
+        if (!m_gw->destroyEntity) throw std::runtime_error("ModuleAPI: destroyEntity unavailable");
+        m_gw->destroyEntity(m_gw->api, e);
+    }
+
+    void destroyEntities(std::span<const Entity> entities) {
+        if (entities.empty()) return;
+        if (m_gw->destroyEntities) {
+            m_gw->destroyEntities(m_gw->api, entities.data(), entities.size());
+            return;
+        }
+        for (Entity e : entities) destroyEntity(e);
+    }
+
+    void destroyEntities(EntityRange range) {
+        destroyEntities(expandRange(range));
+    }
+
+    /**
+     * @brief False once `e` was destroyed, even if its slot was reused.
+     * Cores without entity recycling report every entity as alive.
+     */
+    bool isAlive(Entity e) const {
+        return m_gw->isAlive ? m_gw->isAlive(m_gw->api, e) : true;
+    }
+
+    /**
+     * @brief Asks the core to release sparse pages and spare dense capacity
+     * left by destroyed entities. Returns the number of sparse pages freed.
+     */
+    size_t compactStorage() {
+        return m_gw->compactStorage ? m_gw->compactStorage(m_gw->api) : 0;
+    }
+    
+    // --- Persistence ---
+
+    /**
+     * @brief Writes the entity allocator and every trivially copyable
+     * component registered through this API to `path`.
+     * Returns false if the core can't snapshot or the write failed.
+     */
+    bool saveSnapshot(const std::string& path) {
+        if (!m_gw->saveSnapshot) return false;
+        return m_gw->saveSnapshot(m_gw->api, path.c_str(), m_snapshotLayouts.data(), m_snapshotLayouts.size());
+    }
+
+    /**
+     * @brief Warm start: restores what saveSnapshot wrote, replacing the
+     * current entities and component contents. Register the same components
+     * first. Returns false, leaving the world untouched, when the file is
+     * missing, the core can't restore, or a component's layout changed; the
+     * caller then builds its state from scratch.
+     */
+    bool loadSnapshot(const std::string& path) {
+        if (!m_gw->loadSnapshot) return false;
+        return m_gw->loadSnapshot(m_gw->api, path.c_str(), m_snapshotLayouts.data(), m_snapshotLayouts.size());
+    }
+
     void enqueueTask(const Task& task) {
-        if (m_gw && m_gw->enqueueTask) m_gw->enqueueTask(m_gw->api, task);
+        if (!m_gw || !m_gw->enqueueTask) return;
+#if FRACTAL_PROFILING
+        Task profiled = task;
+        profiled.func = [inner = task.func] {
+            FRACTAL_PROFILE_SCOPE("task/enqueue", Task, 0);
+            inner();
+        };
+        m_gw->enqueueTask(m_gw->api, profiled);
+#else
+        m_gw->enqueueTask(m_gw->api, task);
+#endif
     }
     
     void registerIntervalTask(const TickTask& tickTask) {
-        if (m_gw && m_gw->registerIntervalTask) m_gw->registerIntervalTask(m_gw->api, tickTask);
+        if (!m_gw || !m_gw->registerIntervalTask) return;
+#if FRACTAL_PROFILING
+        TickTask profiled = tickTask;
+        profiled.func = [inner = tickTask.func] {
+            FRACTAL_PROFILE_SCOPE("task/interval", Task, 0);
+            inner();
+        };
+        m_gw->registerIntervalTask(m_gw->api, profiled);
+#else
+        m_gw->registerIntervalTask(m_gw->api, tickTask);
+#endif
+    }
+
+    /**
+     * @brief Queues a task on the core's pool without allocating; `task` is
+     * any callable that fits InlineTask. With a group, wait(group) returns
+     * only once it has run. Cores without inline tasks run it on the spot.
+     */
+    void submit(InlineTask task, WaitGroup* group = nullptr) {
+#if FRACTAL_PROFILING
+        task = profiledTask(std::move(task), "task/submit");
+#endif
+        if (m_gw->submitTask) {
+            m_gw->submitTask(m_gw->api, &task, group);
+            return;
+        }
+        task();
+    }
+
+    /**
+     * @brief Runs `task` once every task counted by `group` has finished,
+     * counting it towards `next`. Arm after submitting the group's tasks;
+     * a group holds one continuation at a time.
+     */
+    void continueWith(WaitGroup& group, InlineTask task, WaitGroup* next = nullptr) {
+#if FRACTAL_PROFILING
+        task = profiledTask(std::move(task), "task/continuation");
+#endif
+        if (m_gw->continueWith) {
+            m_gw->continueWith(m_gw->api, &group, &task, next);
+            return;
+        }
+        // Without inline tasks submit() already ran everything.
+        task();
+    }
+
+    /**
+     * @brief Blocks until `group` is done, running queued tasks meanwhile.
+     */
+    void wait(WaitGroup& group) {
+        if (m_gw->waitGroup) m_gw->waitGroup(m_gw->api, &group);
+    }
+
+    /**
+     * @brief Registers an interval task on the core's timer wheel. Returns
+     * an ID for cancelTickTask, or 0 on cores that only take TickTask.
+     * Safe from any thread, including from inside a task.
+     */
+    uint64_t scheduleTickTask(const TickTaskDesc& desc, InlineTask task) {
+#if FRACTAL_PROFILING
+        task = profiledTask(std::move(task), "task/tick", false);
+#endif
+        if (m_gw->scheduleTickTask) return m_gw->scheduleTickTask(m_gw->api, &task, &desc);
+        if (!m_gw->registerIntervalTask) return 0;
+        // TickTask wants a copyable std::function, so share the task.
+        auto shared = std::make_shared<InlineTask>(std::move(task));
+        TickTask tick{ [shared] { (*shared)(); }, std::chrono::milliseconds(desc.intervalMs), {}, 0,
+                       desc.executions, true, 0.0f, desc.isBackTask };
+        m_gw->registerIntervalTask(m_gw->api, tick);
+        return 0;
+    }
+
+    bool cancelTickTask(uint64_t id) {
+        return m_gw->cancelTickTask ? m_gw->cancelTickTask(m_gw->api, id) : false;
     }
 
     float getDeltaTime() const {
@@ -71,12 +951,57 @@ public:
 
     // --- ECS: Component Management ---
      
+    /**
+     * @brief Registers a component type and returns its interned handle.
+     * The handle equals makeComponentHandle<T>(name), so hot paths may use a
+     * compile-time constant instead of keeping the returned value around.
+     */
     template<typename T>
-    void registerComponent(const std::string& name, size_t capacity = 10000) {
+    ComponentHandle<T> registerComponent(const std::string& name, size_t capacity = 10000) {
+        const ComponentHandle<T> handle{ hashName(name) };
+        if (m_gw && m_gw->registerComponentById) {
+            if (!m_gw->registerComponentById(m_gw->api, handle.id, name.c_str(), sizeof(T), capacity)) {
+                throw std::runtime_error("ModuleAPI: component ID collision for '" + name + "'");
+            }
+            m_componentNames.emplace(handle.id, name);
+            trackSnapshotLayout<T>(handle.id);
+            return handle;
+        }
         if (!m_gw || !m_gw->registerComponent) throw std::runtime_error("ModuleAPI: registerComponent unavailable");
+        // Legacy cores key by name, so a second name hashing to the same ID
+        // would silently share the first one's handle.
+        const auto [it, inserted] = m_componentNames.emplace(handle.id, name);
+        if (!inserted && it->second != name) {
+            throw std::runtime_error("ModuleAPI: component ID collision between '" + it->second + "' and '" + name + "'");
+        }
         m_gw->registerComponent(m_gw->api, name, sizeof(T), capacity);
+        trackSnapshotLayout<T>(handle.id);
+        return handle;
     }
     
+    /**
+     * @brief Registers a component stored as one aligned column per field.
+     * T needs a FRACTAL_SOA_LAYOUT. Columns are reached through
+     * updateParallelColumns. Row passes (chunk, read, changed and range
+     * passes, reductions, spatial indexes) see per-chunk struct copies.
+     * getComponent/readComponent throw for SoA components, and group views
+     * refuse them as members.
+     */
+    template<typename T>
+    ComponentHandle<T> registerComponentSoA(const std::string& name, size_t capacity = 10000) {
+        if (!m_gw->registerComponentSoAById) return registerComponent<T>(name, capacity);
+
+        const ComponentHandle<T> handle{ hashName(name) };
+        const auto fields = soaFieldDescs<T>();
+        if (!m_gw->registerComponentSoAById(m_gw->api, handle.id, name.c_str(), sizeof(T),
+                                            fields.data(), fields.size(), capacity)) {
+            throw std::runtime_error("ModuleAPI: component ID collision for '" + name + "'");
+        }
+        m_componentNames.emplace(handle.id, name);
+        trackSnapshotLayout<T>(handle.id, fields);
+        return handle;
+    }
+
     template<typename T>
     void attachComponent(Entity e, const std::string& name, const T& data) {
         if (!m_gw || !m_gw->attachComponent) throw std::runtime_error("ModuleAPI: attachComponent unavailable");
@@ -97,72 +1022,643 @@ public:
         return (m_gw && m_gw->hasComponent) ? m_gw->hasComponent(m_gw->api, e, name) : false;
     }
 
-    // --- ECS: System & Parallel Processing ---
+    // --- ECS: Handle-based Component Access ---
 
-    /**
-     * @brief Processes multiple components in parallel groups.
-     */
-    void updateParallelGroup(const std::vector<std::string>& componentNames,
-                             void (*updateFunc)(size_t start, size_t end, void* userCtx),
-                             void* userCtx = nullptr,
-                             size_t chunkSize = 1024) {
-        if (m_gw && m_gw->updateParallelGroup) {
-            m_gw->updateParallelGroup(m_gw->api, componentNames, updateFunc, userCtx, chunkSize);
+    template<typename T>
+    void attachComponent(Entity e, ComponentHandle<T> handle, const T& data) {
+        if (m_gw->attachComponentById) {
+            m_gw->attachComponentById(m_gw->api, e, handle.id, (void*)&data);
+        } else if (const std::string* name = componentName(handle.id)) {
+            attachComponent<T>(e, *name, data);
+        } else {
+            throw std::runtime_error("ModuleAPI: attachComponent handle unavailable");
         }
     }
 
-    void registerGroup(const std::vector<std::string>& componentNames) {
-        if (m_gw && m_gw->registerGroup) {
-            m_gw->registerGroup(m_gw->api, componentNames);
+    template<typename T>
+    void removeComponent(Entity e, ComponentHandle<T> handle) {
+        if (m_gw->removeComponentById) {
+            m_gw->removeComponentById(m_gw->api, e, handle.id);
+        } else if (const std::string* name = componentName(handle.id)) {
+            removeComponent(e, *name);
+        }
+    }
+
+    template<typename T>
+    T* getComponent(Entity e, ComponentHandle<T> handle) {
+        if (m_gw->getComponentById) {
+            return static_cast<T*>(m_gw->getComponentById(m_gw->api, e, handle.id));
         }
+        const std::string* name = componentName(handle.id);
+        return name ? getComponent<T>(e, *name) : nullptr;
     }
 
     /**
-     * @brief High-level system registration with automatic trampoline creation.
+     * @brief Read-only lookup. Unlike getComponent it does not count as a
+     * change for OnChanged systems.
      */
     template<typename T>
-    void registerSystem(const std::string& componentName,
-                        void (*updateFunc)(Entity, T&, float),
-                        TriggerType trigger = TriggerType::Always,
-                        float timeInterval = 0.0f, 
-                        size_t tickInterval = 0) {
-        
+    const T* readComponent(Entity e, ComponentHandle<T> handle) {
+        if (m_gw->readComponentById) {
+            return static_cast<const T*>(m_gw->readComponentById(m_gw->api, e, handle.id));
+        }
+        return getComponent(e, handle);
+    }
+
+    /**
+     * @brief Flags a component as changed after writing it through a pointer
+     * the core didn't hand out for writing (e.g. one from readComponent).
+     */
+    template<typename T>
+    void markChanged(Entity e, ComponentHandle<T> handle) {
+        if (m_gw->markChangedById) m_gw->markChangedById(m_gw->api, e, handle.id);
+    }
+
+    template<typename T>
+    bool hasComponent(Entity e, ComponentHandle<T> handle) {
+        if (m_gw->hasComponentById) return m_gw->hasComponentById(m_gw->api, e, handle.id);
+        const std::string* name = componentName(handle.id);
+        return name ? hasComponent(e, *name) : false;
+    }
+
+    /**
+     * @brief Attaches data[i] to entities[i] for the whole batch in one gateway call.
+     * An entity listed twice ends up with its last value, as with attachComponent.
+     */
+    template<typename T>
+    void attachComponents(std::span<const Entity> entities, ComponentHandle<T> handle, std::span<const T> data) {
+        static_assert(std::is_trivially_copyable_v<T>, "bulk attach copies components bytewise");
+        if (entities.size() != data.size()) throw std::invalid_argument("ModuleAPI: attachComponents size mismatch");
+        if (m_gw->attachComponentsById) {
+            m_gw->attachComponentsById(m_gw->api, handle.id, entities.data(), data.data(), entities.size());
+            return;
+        }
+        for (size_t i = 0; i < entities.size(); ++i) attachComponent(entities[i], handle, data[i]);
+    }
+
+    template<typename T>
+    void attachComponents(EntityRange entities, ComponentHandle<T> handle, std::span<const T> data) {
+        attachComponents<T>(expandRange(entities), handle, data);
+    }
+
+    /**
+     * @brief Prefab-style bulk attach: stamps a copy of `value` onto every entity.
+     */
+    template<typename T>
+    void attachPrefab(std::span<const Entity> entities, ComponentHandle<T> handle, const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "bulk attach copies components bytewise");
+        if (m_gw->attachComponentFillById) {
+            m_gw->attachComponentFillById(m_gw->api, handle.id, entities.data(), &value, entities.size());
+            return;
+        }
+        for (Entity e : entities) attachComponent(e, handle, value);
+    }
+
+    template<typename T>
+    void attachPrefab(EntityRange entities, ComponentHandle<T> handle, const T& value) {
+        attachPrefab<T>(expandRange(entities), handle, value);
+    }
+
+    /**
+     * @brief Replays every thread's recorded commands and clears them.
+     * Pending entities are created in one createEntities() call. Attach and
+     * remove commands are then grouped per component, so each component's
+     * storage is mutated once per run of same-kind commands rather than once
+     * per command. Commands for one component keep their recording order.
+     */
+    void playbackCommands(CommandQueue& queue) {
+        struct Resolved {
+            uint32_t componentId;
+            CommandBuffer::Kind kind;
+            Entity entity;
+            const std::byte* payload;
+            uint32_t size;
+        };
+
+        size_t pendingTotal = 0;
+        for (const auto& buffer : queue.buffers()) pendingTotal += buffer->createdEntities();
+        EntityRange created = createEntities(pendingTotal);
+
+        std::vector<Resolved> commands;
+        size_t pendingBase = 0;
+        for (const auto& buffer : queue.buffers()) {
+            for (const CommandBuffer::Command& c : buffer->commands()) {
+                Entity e = c.pending ? created[pendingBase + c.entity] : Entity{ c.entity };
+                commands.push_back(Resolved{ c.componentId, c.kind, e, buffer->payload(c), c.size });
+            }
+            pendingBase += buffer->createdEntities();
+        }
+        // Destroys go last so attaches/removes recorded for the same entity
+        // don't hit a recycled slot.
+        std::stable_sort(commands.begin(), commands.end(), [](const Resolved& a, const Resolved& b) {
+            const bool aDestroy = a.kind == CommandBuffer::Kind::Destroy;
+            const bool bDestroy = b.kind == CommandBuffer::Kind::Destroy;
+            if (aDestroy != bDestroy) return bDestroy;
+            return a.componentId < b.componentId;
+        });
+
+        std::vector<Entity> entities;
+        std::vector<std::byte> payload;
+        for (size_t begin = 0; begin < commands.size();) {
+            const Resolved& head = commands[begin];
+            size_t end = begin;
+            entities.clear();
+            payload.clear();
+            while (end < commands.size() && commands[end].componentId == head.componentId &&
+                   commands[end].kind == head.kind && commands[end].size == head.size) {
+                entities.push_back(commands[end].entity);
+                payload.insert(payload.end(), commands[end].payload, commands[end].payload + commands[end].size);
+                ++end;
+            }
+
+            if (head.kind == CommandBuffer::Kind::Attach) {
+                attachComponentsRaw(head.componentId, entities, payload.data(), head.size);
+            } else if (head.kind == CommandBuffer::Kind::Remove) {
+                removeComponentsRaw(head.componentId, entities);
+            } else {
+                destroyEntities(std::span<const Entity>(entities));
+            }
+            begin = end;
+        }
+
+        for (const auto& buffer : queue.buffers()) buffer->clear();
+    }
+
+    template<typename T>
+    ComponentData* getComponentData(ComponentHandle<T> handle) {
+        return componentDataById(handle.id);
+    }
+
+    // --- ECS: System & Parallel Processing ---
+
+    /**
+     * @brief Processes multiple components in parallel groups.
+     */
+    void updateParallelGroup(const std::vector<std::string>& componentNames,
+                             void (*updateFunc)(size_t start, size_t end, void* userCtx),
+                             void* userCtx = nullptr,
+                             size_t chunkSize = 1024) {
+        if (!m_gw || !m_gw->updateParallelGroup) return;
+        if (chunkSize == AutoChunkSize) {
+            uint32_t key = 0;
+            for (const std::string& name : componentNames) key = key * 31u + hashName(name);
+            ChunkTuner* tuner = chunkTuner(TunedPass::Group, key, [&] {
+                std::string label;
+                for (const std::string& name : componentNames) label += (label.empty() ? "" : "+") + name;
+                return label + "/group";
+            });
+            chunking_detail::TimedChunks<size_t, size_t> timed{ updateFunc, userCtx, tuner };
+            m_gw->updateParallelGroup(m_gw->api, componentNames, &decltype(timed)::invoke, &timed, tuner->chunkSize());
+            tuner->endPass();
+            return;
+        }
+        m_gw->updateParallelGroup(m_gw->api, componentNames, updateFunc, userCtx, chunkSize);
+    }
+
+    void registerGroup(const std::vector<std::string>& componentNames) {
+        if (m_gw && m_gw->registerGroup) {
+            m_gw->registerGroup(m_gw->api, componentNames);
+        }
+    }
+
+    /**
+     * @brief Registers a group from component handles and returns its typed handle.
+     */
+    template<typename... Ts>
+    GroupHandle<Ts...> registerGroup(ComponentHandle<Ts>... handles) {
+        GroupHandle<Ts...> group{ { handles.id... } };
+        if (m_gw->registerGroupById) {
+            m_gw->registerGroupById(m_gw->api, group.ids.data(), group.ids.size());
+        } else {
+            registerGroup(groupNames(group));
+        }
+        return group;
+    }
+
+    /**
+     * @brief Typed parallel iteration over a group.
+     * The callback gets each packed chunk as a GroupView with one span per
+     * component, all indexed in lockstep.
+     */
+    template<typename... Ts>
+    void updateParallelGroup(GroupHandle<Ts...> group,
+                             void (*func)(GroupView<Ts...>, void*),
+                             void* userCtx = nullptr,
+                             size_t chunkSize = 1024) {
+        GroupViewCtx<Ts...> ctx{ func, userCtx, {}, nullptr };
+        std::array<ComponentData*, sizeof...(Ts)> data{};
+        for (size_t i = 0; i < data.size(); ++i) data[i] = componentDataById(group.ids[i]);
+        if (!bindGroupColumns(ctx, data, group.ids)) return;
+
+        if (!m_gw->updateParallelGroupById) {
+            updateParallelGroup(groupNames(group), &groupViewTrampoline<Ts...>, &ctx, chunkSize);
+            return;
+        }
+        if (chunkSize == AutoChunkSize) {
+            uint32_t key = 0;
+            for (uint32_t id : group.ids) key = key * 31u + id;
+            ChunkTuner* tuner = chunkTuner(TunedPass::Group, key, [&] { return groupLabel(group.ids) + "/group"; });
+            chunking_detail::TimedChunks<size_t, size_t> timed{ &groupViewTrampoline<Ts...>, &ctx, tuner };
+            m_gw->updateParallelGroupById(m_gw->api, group.ids.data(), group.ids.size(),
+                                          &decltype(timed)::invoke, &timed, tuner->chunkSize());
+            tuner->endPass();
+            return;
+        }
+        m_gw->updateParallelGroupById(m_gw->api, group.ids.data(), group.ids.size(),
+                                      &groupViewTrampoline<Ts...>, &ctx, chunkSize);
+    }
+
+    /**
+     * @brief Typed group iteration for groups registered by name.
+     */
+    template<typename... Ts>
+    void updateParallelGroup(const std::vector<std::string>& componentNames,
+                             void (*func)(GroupView<Ts...>, void*),
+                             void* userCtx = nullptr,
+                             size_t chunkSize = 1024) {
+        if (componentNames.size() != sizeof...(Ts)) {
+            throw std::invalid_argument("ModuleAPI: updateParallelGroup needs one name per component type");
+        }
+        if (!m_gw->getComponentData) return;
+
+        GroupViewCtx<Ts...> ctx{ func, userCtx, {}, nullptr };
+        std::array<ComponentData*, sizeof...(Ts)> data{};
+        std::array<uint32_t, sizeof...(Ts)> ids{};
+        for (size_t i = 0; i < data.size(); ++i) {
+            data[i] = m_gw->getComponentData(m_gw->api, componentNames[i]);
+            ids[i] = hashName(componentNames[i]);
+        }
+        if (!bindGroupColumns(ctx, data, ids)) return;
+
+        updateParallelGroup(componentNames, &groupViewTrampoline<Ts...>, &ctx, chunkSize);
+    }
+
+    /**
+     * @brief High-level system registration with automatic trampoline creation.
+     * Like every typed overload, the system declares access to its own
+     * component only. If the callback also touches other components (say
+     * through getComponent), register it with a SystemConfig that lists
+     * them, or it races with the systems scheduled alongside it.
+     */
+    template<typename T>
+    void registerSystem(const std::string& componentName,
+                        void (*updateFunc)(Entity, T&, float),
+                        TriggerType trigger = TriggerType::Always,
+                        float timeInterval = 0.0f, 
+                        size_t tickInterval = 0,
+                        size_t chunkSize = AutoChunkSize) {
+        
         struct SystemModuleContext {
             std::string compName;
             void (*uFunc)(Entity, T&, float);
             FractalCORE_Gateway* gateway;
             float currentDt;
+            size_t chunkSize;
+            ChunkTuner* tuner;
         };
         
-        auto* moduleContext = new SystemModuleContext{ componentName, updateFunc, m_gw, 0.0f };
         std::string systemName = componentName + "_UpdateSystem"; 
+        ChunkTuner* tuner = chunkSize == AutoChunkSize
+            ? chunkTuner(TunedPass::System, hashName(systemName), [&] { return systemName; })
+            : nullptr;
+        auto* moduleContext = m_contexts.make<SystemModuleContext>(componentName, updateFunc, m_gw, 0.0f, chunkSize, tuner);
 
         // Trampoline to bridge C-style callback with typed component data
         auto core_trampoline = [](float dt, void* userData) {
             auto* ctx = static_cast<SystemModuleContext*>(userData);
             ctx->currentDt = dt; 
             
+            if (ctx->gateway->updateParallelChunks) {
+                // One indirect call per entity instead of two.
+                auto chunk_callback = [](const Entity* entities, void* raw_data, size_t count, void* userCtx) {
+                    auto* sCtx = static_cast<SystemModuleContext*>(userCtx);
+                    T* components = static_cast<T*>(raw_data);
+                    for (size_t i = 0; i < count; ++i) {
+                        sCtx->uFunc(entities[i], components[i], sCtx->currentDt);
+                    }
+                };
+                dispatchChunks(ctx->gateway, ctx->compName, chunk_callback, ctx, ctx->chunkSize, ctx->tuner);
+                return;
+            }
+
             auto entity_callback = [](Entity e, void* raw_data, void* userCtx) {
                 auto* sCtx = static_cast<SystemModuleContext*>(userCtx);
                 T& component = *static_cast<T*>(raw_data);
                 sCtx->uFunc(e, component, sCtx->currentDt);
             };
 
-            ctx->gateway->updateParallel(ctx->gateway->api, ctx->compName, entity_callback, ctx, 64);
+            // Per-entity callbacks can't be timed per chunk; use the last tuned size.
+            const size_t chunk = ctx->tuner ? ctx->tuner->chunkSize() : ctx->chunkSize;
+            ctx->gateway->updateParallel(ctx->gateway->api, ctx->compName, entity_callback, ctx, chunk);
         };
 
-        m_gw->registerSystem(m_gw->api, systemName, core_trampoline, static_cast<void*>(moduleContext));
+        registerSystemTrampoline(systemName, core_trampoline, static_cast<void*>(moduleContext));
 
-        SystemDesc desc;
+        SystemConfig desc;
         desc.systemName = systemName;
         desc.trigger = trigger;
         desc.timeInterval = timeInterval;
         desc.tickInterval = tickInterval;
         desc.enabled = true;
-        
-        m_gw->registerSystemInLoop(m_gw->api, desc);
+        desc.writes = { hashName(componentName) };
+
+        registerInLoop(desc);
     }
     
+    /**
+     * @brief Registers a raw system with a full loop description, including
+     * the components it reads/writes and its ordering against other systems.
+     */
+    void registerSystem(const SystemConfig& config, void (*updateFunc)(float, void*), void* userData = nullptr) {
+        if (!m_gw->registerSystem || !m_gw->registerSystemInLoop) throw std::runtime_error("ModuleAPI: registerSystem unavailable");
+        registerSystemTrampoline(config.systemName, updateFunc, userData);
+        registerInLoop(config);
+    }
+
+    // --- Adaptive Chunk Sizing ---
+
+    /**
+     * @brief Target per-chunk execution time for passes run with AutoChunkSize.
+     * Applies to tuners created after the call.
+     */
+    void setAutoChunkTarget(std::chrono::nanoseconds target) {
+        m_autoChunkTarget = target;
+    }
+
+    /**
+     * @brief Current tuned chunk sizes, e.g. to pin them in production builds.
+     */
+    std::vector<ChunkTuner::Report> chunkSizeReport() const {
+        std::vector<ChunkTuner::Report> reports;
+        {
+            std::lock_guard<std::mutex> lock(m_tunerMutex);
+            reports.reserve(m_chunkTuners.size());
+            for (const auto& [key, tuner] : m_chunkTuners) reports.push_back(tuner->report());
+        }
+        std::sort(reports.begin(), reports.end(), [](const auto& a, const auto& b) { return a.label < b.label; });
+        return reports;
+    }
+
+    /**
+     * @brief System registration with a chunk-level update function.
+     * The callback sees whole packed chunks rather than one entity at a time.
+     * With TriggerType::Budgeted, timeInterval is the per-frame budget in
+     * seconds (see the SystemConfig overload). Declares a write of the
+     * component only.
+     */
+    template<typename T>
+    void registerSystem(const std::string& componentName,
+                        void (*updateFunc)(std::span<const Entity>, std::span<T>, float),
+                        TriggerType trigger = TriggerType::Always,
+                        float timeInterval = 0.0f,
+                        size_t tickInterval = 0,
+                        size_t chunkSize = AutoChunkSize) {
+        if (trigger == TriggerType::Budgeted) {
+            SystemConfig desc;
+            desc.systemName = componentName + "_UpdateSystem";
+            desc.trigger = trigger;
+            desc.budget = timeInterval;
+            registerSystem(makeComponentHandle<T>(componentName), updateFunc, std::move(desc), chunkSize);
+            return;
+        }
+
+        struct ChunkSystemContext {
+            std::string compName;
+            void (*uFunc)(std::span<const Entity>, std::span<T>, float);
+            FractalCORE_Gateway* gateway;
+            float currentDt;
+            size_t chunkSize;
+            ChunkTuner* tuner;
+        };
+
+        std::string systemName = componentName + "_UpdateSystem";
+        ChunkTuner* tuner = chunkSize == AutoChunkSize
+            ? chunkTuner(TunedPass::System, hashName(systemName), [&] { return systemName; })
+            : nullptr;
+        auto* moduleContext = m_contexts.make<ChunkSystemContext>(componentName, updateFunc, m_gw, 0.0f, chunkSize, tuner);
+
+        auto core_trampoline = [](float dt, void* userData) {
+            auto* ctx = static_cast<ChunkSystemContext*>(userData);
+            ctx->currentDt = dt;
+
+            auto chunk_callback = [](const Entity* entities, void* raw_data, size_t count, void* userCtx) {
+                auto* sCtx = static_cast<ChunkSystemContext*>(userCtx);
+                sCtx->uFunc(std::span<const Entity>(entities, count),
+                            std::span<T>(static_cast<T*>(raw_data), count),
+                            sCtx->currentDt);
+            };
+            dispatchChunks(ctx->gateway, ctx->compName, chunk_callback, ctx, ctx->chunkSize, ctx->tuner);
+        };
+
+        registerSystemTrampoline(systemName, core_trampoline, static_cast<void*>(moduleContext));
+
+        SystemConfig desc;
+        desc.systemName = systemName;
+        desc.trigger = trigger;
+        desc.timeInterval = timeInterval;
+        desc.tickInterval = tickInterval;
+        desc.enabled = true;
+        desc.writes = { hashName(componentName) };
+
+        registerInLoop(desc);
+    }
+
+    /**
+     * @brief Chunk-level system with a full loop description (ordering,
+     * extra reads/writes, trigger); the component is added to desc.writes.
+     * List every other component the callback reads or writes.
+     *
+     * With TriggerType::Budgeted the system gets desc.budget seconds per
+     * frame and walks the component incrementally, resuming next frame
+     * where it stopped, so an expensive system is spread over several
+     * frames instead of spiking one. Its callback's dt is then the time
+     * between two visits of the same entity (one sweep). budgetReport()
+     * shows how far behind each budgeted system runs.
+     */
+    template<typename T>
+    void registerSystem(ComponentHandle<T> handle,
+                        void (*updateFunc)(std::span<const Entity>, std::span<T>, float),
+                        SystemConfig desc,
+                        size_t chunkSize = AutoChunkSize) {
+        struct DescSystemContext {
+            ModuleAPI* api;
+            uint32_t compId;
+            void (*uFunc)(std::span<const Entity>, std::span<T>, float);
+            float currentDt;
+            size_t chunkSize;
+            ChunkTuner* tuner;
+            BudgetedCursor* budget;
+        };
+
+        if (desc.systemName.empty()) desc.systemName = componentLabel(handle.id) + "_UpdateSystem";
+        ChunkTuner* tuner = chunkSize == AutoChunkSize
+            ? chunkTuner(TunedPass::System, hashName(desc.systemName), [&] { return desc.systemName; })
+            : nullptr;
+        BudgetedCursor* budget = nullptr;
+        if (desc.trigger == TriggerType::Budgeted) {
+            const auto ns = std::chrono::duration<double>(std::max(desc.budget, 0.0f));
+            budget = m_contexts.make<BudgetedCursor>(desc.systemName,
+                                                     std::chrono::duration_cast<std::chrono::nanoseconds>(ns));
+            m_budgetedSystems.push_back(budget);
+        }
+        auto* moduleContext = m_contexts.make<DescSystemContext>(this, handle.id, updateFunc, 0.0f, chunkSize, tuner, budget);
+
+        auto core_trampoline = [](float dt, void* userData) {
+            auto* ctx = static_cast<DescSystemContext*>(userData);
+            auto chunk_callback = [](const Entity* entities, void* raw_data, size_t count, void* userCtx) {
+                auto* sCtx = static_cast<DescSystemContext*>(userCtx);
+                sCtx->uFunc(std::span<const Entity>(entities, count),
+                            std::span<T>(static_cast<T*>(raw_data), count),
+                            sCtx->currentDt);
+            };
+            if (!ctx->budget) {
+                ctx->currentDt = dt;
+                ctx->api->dispatchChunks(ctx->compId, chunk_callback, ctx, ctx->chunkSize, ctx->tuner);
+                return;
+            }
+            const ComponentData* cd = ctx->api->componentDataById(ctx->compId);
+            ctx->budget->run(dt, cd ? cd->dense.size() : 0, [&](size_t begin, size_t end, float elementDt) {
+                ctx->currentDt = elementDt;
+                ctx->api->dispatchRange(ctx->compId, begin, end, chunk_callback, ctx, ctx->chunkSize, ctx->tuner);
+            });
+        };
+
+        registerSystemTrampoline(desc.systemName, core_trampoline, static_cast<void*>(moduleContext));
+
+        if (desc.trigger == TriggerType::Budgeted) desc.trigger = TriggerType::Always;
+        desc.enabled = true;
+        if (std::find(desc.writes.begin(), desc.writes.end(), handle.id) == desc.writes.end()) desc.writes.push_back(handle.id);
+        registerInLoop(desc);
+    }
+
+    /**
+     * @brief How far behind each Budgeted system runs: elements left in the
+     * current sweep, and how many frames and seconds the last sweep took.
+     */
+    std::vector<BudgetedCursor::Report> budgetReport() const {
+        std::vector<BudgetedCursor::Report> reports;
+        reports.reserve(m_budgetedSystems.size());
+        for (const BudgetedCursor* cursor : m_budgetedSystems) reports.push_back(cursor->report());
+        return reports;
+    }
+
+    /**
+     * @brief Read-only system over a component. With TriggerType::OnChanged
+     * (the default) each run only visits chunks changed since the previous
+     * run; other triggers visit every chunk. Declares a read of the
+     * component, so it can run alongside other readers.
+     */
+    template<typename T>
+    void registerSystem(const std::string& componentName,
+                        void (*updateFunc)(std::span<const Entity>, std::span<const T>, float),
+                        TriggerType trigger = TriggerType::OnChanged,
+                        float timeInterval = 0.0f,
+                        size_t tickInterval = 0,
+                        size_t chunkSize = 1024) {
+
+        struct ChangedSystemContext {
+            std::string compName;
+            uint32_t compId;
+            void (*uFunc)(std::span<const Entity>, std::span<const T>, float);
+            FractalCORE_Gateway* gateway;
+            float currentDt;
+            size_t chunkSize;
+            ChunkTuner* tuner;
+            bool changedOnly;
+            ChangeCursor cursor;
+        };
+
+        const bool changedOnly = trigger == TriggerType::OnChanged;
+        std::string systemName = componentName + (changedOnly ? "_ChangedSystem" : "_ReadSystem");
+        ChunkTuner* tuner = chunkSize == AutoChunkSize
+            ? chunkTuner(TunedPass::System, hashName(systemName), [&] { return systemName; })
+            : nullptr;
+        auto* moduleContext = m_contexts.make<ChangedSystemContext>(componentName, hashName(componentName), updateFunc,
+                                                                    m_gw, 0.0f, chunkSize, tuner, changedOnly,
+                                                                    ChangeCursor{});
+
+        auto core_trampoline = [](float dt, void* userData) {
+            auto* ctx = static_cast<ChangedSystemContext*>(userData);
+            ctx->currentDt = dt;
+
+            auto chunk_callback = [](const Entity* entities, void* raw_data, size_t count, void* userCtx) {
+                auto* sCtx = static_cast<ChangedSystemContext*>(userCtx);
+                sCtx->uFunc(std::span<const Entity>(entities, count),
+                            std::span<const T>(static_cast<const T*>(raw_data), count),
+                            sCtx->currentDt);
+            };
+            // A fresh cursor visits everything without the write stamps a
+            // mutable pass would leave for other OnChanged systems.
+            ChangeCursor everything;
+            dispatchChanged(ctx->gateway, ctx->compId, &ctx->compName, ctx->changedOnly ? ctx->cursor : everything,
+                            chunk_callback, ctx, ctx->chunkSize, ctx->tuner);
+        };
+
+        registerSystemTrampoline(systemName, core_trampoline, static_cast<void*>(moduleContext));
+
+        SystemConfig desc;
+        desc.systemName = systemName;
+        desc.trigger = changedOnly ? TriggerType::Always : trigger;
+        desc.timeInterval = timeInterval;
+        desc.tickInterval = tickInterval;
+        desc.enabled = true;
+        desc.reads = { hashName(componentName) };
+
+        registerInLoop(desc);
+    }
+
+    /**
+     * @brief System registration for a component stored with registerComponentSoA.
+     */
+    template<typename T>
+    void registerSystem(const std::string& componentName,
+                        void (*updateFunc)(SoAChunk<T>, float),
+                        TriggerType trigger = TriggerType::Always,
+                        float timeInterval = 0.0f,
+                        size_t tickInterval = 0,
+                        size_t chunkSize = AutoChunkSize) {
+
+        struct ColumnSystemContext {
+            std::string compName;
+            uint32_t compId;
+            void (*uFunc)(SoAChunk<T>, float);
+            FractalCORE_Gateway* gateway;
+            float currentDt;
+            size_t chunkSize;
+            ChunkTuner* tuner;
+        };
+
+        std::string systemName = componentName + "_UpdateSystem";
+        ChunkTuner* tuner = chunkSize == AutoChunkSize
+            ? chunkTuner(TunedPass::System, hashName(systemName), [&] { return systemName; })
+            : nullptr;
+        auto* moduleContext = m_contexts.make<ColumnSystemContext>(componentName, hashName(componentName), updateFunc,
+                                                                   m_gw, 0.0f, chunkSize, tuner);
+
+        auto core_trampoline = [](float dt, void* userData) {
+            auto* ctx = static_cast<ColumnSystemContext*>(userData);
+            ctx->currentDt = dt;
+
+            auto column_callback = [](const Entity* entities, void* const* columns, size_t count, void* userCtx) {
+                auto* sCtx = static_cast<ColumnSystemContext*>(userCtx);
+                sCtx->uFunc(SoAChunk<T>(entities, columns, count), sCtx->currentDt);
+            };
+            dispatchColumns<T>(ctx->gateway, ctx->compId, &ctx->compName, column_callback, ctx, ctx->chunkSize, ctx->tuner);
+        };
+
+        registerSystemTrampoline(systemName, core_trampoline, static_cast<void*>(moduleContext));
+
+        SystemConfig desc;
+        desc.systemName = systemName;
+        desc.trigger = trigger;
+        desc.timeInterval = timeInterval;
+        desc.tickInterval = tickInterval;
+        desc.enabled = true;
+        desc.writes = { hashName(componentName) };
+
+        registerInLoop(desc);
+    }
+
     /**
      * @brief Direct parallel iteration over a specific component type.
      */
@@ -172,10 +1668,27 @@ public:
                         size_t chunkSize = 64) {
         if (!m_gw || !m_gw->updateParallel) return;
 
+        // Lives on the stack: the core only uses it until the pass returns.
         struct SimpleFuncCtx {
             void (*f)(Entity, T&);
         };
-        auto* ctx = new SimpleFuncCtx{ func };
+        SimpleFuncCtx ctx{ func };
+
+        if (m_gw->updateParallelChunks) {
+            auto chunk_func = [](const Entity* entities, void* data, size_t count, void* userCtx) {
+                auto* sCtx = static_cast<SimpleFuncCtx*>(userCtx);
+                T* components = static_cast<T*>(data);
+                for (size_t i = 0; i < count; ++i) {
+                    sCtx->f(entities[i], components[i]);
+                }
+            };
+            ChunkTuner* tuner = chunkSize == AutoChunkSize
+                ? chunkTuner(TunedPass::Entities, hashName(componentName), [&] { return componentName + "/updateParallel"; })
+                : nullptr;
+            dispatchChunks(m_gw, componentName, chunk_func, &ctx, chunkSize, tuner);
+            return;
+        }
+        if (chunkSize == AutoChunkSize) chunkSize = 64;
 
         auto wrapper_func = [](Entity e, void* data, void* userCtx) {
             auto* sCtx = static_cast<SimpleFuncCtx*>(userCtx);
@@ -183,7 +1696,387 @@ public:
             sCtx->f(e, component);
         };
         
-        m_gw->updateParallel(m_gw->api, componentName, wrapper_func, ctx, chunkSize);
+        m_gw->updateParallel(m_gw->api, componentName, wrapper_func, &ctx, chunkSize);
+    }
+
+    /**
+     * @brief Chunk-level parallel iteration over a specific component type.
+     * The callback receives each packed chunk as parallel spans of entity IDs
+     * and components, so its inner loop can be inlined and vectorized.
+     */
+    template<typename T>
+    void updateParallelChunks(const std::string& componentName,
+                              void (*func)(std::span<const Entity>, std::span<T>, void*),
+                              void* userCtx = nullptr,
+                              size_t chunkSize = 1024) {
+        if (!m_gw) return;
+
+        struct ChunkFuncCtx {
+            void (*f)(std::span<const Entity>, std::span<T>, void*);
+            void* user;
+        };
+        // The core finishes every chunk before returning, so the context can live on the stack.
+        ChunkFuncCtx ctx{ func, userCtx };
+
+        auto chunk_func = [](const Entity* entities, void* data, size_t count, void* userCtx) {
+            auto* cCtx = static_cast<ChunkFuncCtx*>(userCtx);
+            cCtx->f(std::span<const Entity>(entities, count),
+                    std::span<T>(static_cast<T*>(data), count),
+                    cCtx->user);
+        };
+        ChunkTuner* tuner = chunkSize == AutoChunkSize
+            ? chunkTuner(TunedPass::Chunks, hashName(componentName), [&] { return componentName + "/updateParallelChunks"; })
+            : nullptr;
+        dispatchChunks(m_gw, componentName, chunk_func, &ctx, chunkSize, tuner);
+    }
+
+    template<typename T>
+    void updateParallelChunks(ComponentHandle<T> handle,
+                              void (*func)(std::span<const Entity>, std::span<T>, void*),
+                              void* userCtx = nullptr,
+                              size_t chunkSize = 1024) {
+        struct ChunkFuncCtx {
+            void (*f)(std::span<const Entity>, std::span<T>, void*);
+            void* user;
+        };
+        ChunkFuncCtx ctx{ func, userCtx };
+
+        auto chunk_func = [](const Entity* entities, void* data, size_t count, void* userCtx) {
+            auto* cCtx = static_cast<ChunkFuncCtx*>(userCtx);
+            cCtx->f(std::span<const Entity>(entities, count),
+                    std::span<T>(static_cast<T*>(data), count),
+                    cCtx->user);
+        };
+        ChunkTuner* tuner = chunkSize == AutoChunkSize
+            ? chunkTuner(TunedPass::Chunks, handle.id, [&] { return componentLabel(handle.id) + "/updateParallelChunks"; })
+            : nullptr;
+        dispatchChunks(handle.id, chunk_func, &ctx, chunkSize, tuner);
+    }
+
+    /**
+     * @brief Read-only chunk iteration over the components changed since
+     * `cursor` (attached, fetched with getComponent, marked, or visited by a
+     * mutable pass), advancing the cursor. Work is proportional to what
+     * changed; granularity is the core's change block, so unchanged
+     * neighbours of a changed entity may be visited too.
+     */
+    template<typename T>
+    void updateParallelChanged(ComponentHandle<T> handle,
+                               ChangeCursor& cursor,
+                               void (*func)(std::span<const Entity>, std::span<const T>, void*),
+                               void* userCtx = nullptr,
+                               size_t chunkSize = 1024) {
+        struct ChangedFuncCtx {
+            void (*f)(std::span<const Entity>, std::span<const T>, void*);
+            void* user;
+        };
+        ChangedFuncCtx ctx{ func, userCtx };
+
+        auto chunk_func = [](const Entity* entities, void* data, size_t count, void* userCtx) {
+            auto* cCtx = static_cast<ChangedFuncCtx*>(userCtx);
+            cCtx->f(std::span<const Entity>(entities, count),
+                    std::span<const T>(static_cast<const T*>(data), count),
+                    cCtx->user);
+        };
+        ChunkTuner* tuner = chunkSize == AutoChunkSize
+            ? chunkTuner(TunedPass::Changed, handle.id, [&] { return componentLabel(handle.id) + "/updateParallelChanged"; })
+            : nullptr;
+        dispatchChanged(m_gw, handle.id, componentName(handle.id), cursor, chunk_func, &ctx, chunkSize, tuner);
+    }
+
+    /**
+     * @brief Parallel iteration over the columns of an SoA component.
+     * Pair with the simd:: kernels for 4/8-wide float processing.
+     */
+    template<typename T>
+    void updateParallelColumns(ComponentHandle<T> handle,
+                               void (*func)(SoAChunk<T>, void*),
+                               void* userCtx = nullptr,
+                               size_t chunkSize = 1024) {
+        struct ColumnFuncCtx {
+            void (*f)(SoAChunk<T>, void*);
+            void* user;
+        };
+        ColumnFuncCtx ctx{ func, userCtx };
+
+        auto column_func = [](const Entity* entities, void* const* columns, size_t count, void* userCtx) {
+            auto* cCtx = static_cast<ColumnFuncCtx*>(userCtx);
+            cCtx->f(SoAChunk<T>(entities, columns, count), cCtx->user);
+        };
+        ChunkTuner* tuner = chunkSize == AutoChunkSize
+            ? chunkTuner(TunedPass::Columns, handle.id, [&] { return componentLabel(handle.id) + "/updateParallelColumns"; })
+            : nullptr;
+        dispatchColumns<T>(m_gw, handle.id, componentName(handle.id), column_func, &ctx, chunkSize, tuner);
+    }
+
+    template<typename T>
+    void updateParallel(ComponentHandle<T> handle,
+                        void (*func)(Entity, T&),
+                        size_t chunkSize = 64) {
+        struct SimpleFuncCtx {
+            void (*f)(Entity, T&);
+        };
+        SimpleFuncCtx ctx{ func };
+
+        if (!hasChunkPasses()) {
+            updateParallel<T>(legacyComponentName(handle.id), func, chunkSize);
+            return;
+        }
+        auto chunk_func = [](const Entity* entities, void* data, size_t count, void* userCtx) {
+            auto* sCtx = static_cast<SimpleFuncCtx*>(userCtx);
+            T* components = static_cast<T*>(data);
+            for (size_t i = 0; i < count; ++i) {
+                sCtx->f(entities[i], components[i]);
+            }
+        };
+        ChunkTuner* tuner = chunkSize == AutoChunkSize
+            ? chunkTuner(TunedPass::Entities, handle.id, [&] { return componentLabel(handle.id) + "/updateParallel"; })
+            : nullptr;
+        dispatchChunks(handle.id, chunk_func, &ctx, chunkSize, tuner);
+    }
+
+    /**
+     * @brief updateParallel with the callback bound at compile time, e.g.
+     * `api.updateParallel<&Move>(PositionHandle)`. The trampoline calls Func
+     * directly, so no context is passed and the call can be inlined.
+     */
+    template<auto Func, typename T>
+    void updateParallel(ComponentHandle<T> handle, size_t chunkSize = 64) {
+        static_assert(std::is_invocable_v<decltype(Func), Entity, T&>,
+                      "updateParallel<Func>: Func must be callable as void(Entity, T&)");
+
+        if (!hasChunkPasses()) {
+            updateParallel<T>(legacyComponentName(handle.id), +[](Entity e, T& component) { Func(e, component); }, chunkSize);
+            return;
+        }
+        auto chunk_func = [](const Entity* entities, void* data, size_t count, void*) {
+            T* components = static_cast<T*>(data);
+            for (size_t i = 0; i < count; ++i) {
+                Func(entities[i], components[i]);
+            }
+        };
+        ChunkTuner* tuner = chunkSize == AutoChunkSize
+            ? chunkTuner(TunedPass::Entities, handle.id, [&] { return componentLabel(handle.id) + "/updateParallel"; })
+            : nullptr;
+        dispatchChunks(handle.id, chunk_func, nullptr, chunkSize, tuner);
+    }
+
+    /**
+     * @brief Read-only chunk iteration over every component. Unlike
+     * updateParallelChunks it does not mark the component as changed.
+     */
+    template<typename T>
+    void readParallelChunks(ComponentHandle<T> handle,
+                            void (*func)(std::span<const Entity>, std::span<const T>, void*),
+                            void* userCtx = nullptr,
+                            size_t chunkSize = 1024) {
+        struct ReadFuncCtx {
+            void (*f)(std::span<const Entity>, std::span<const T>, void*);
+            void* user;
+        };
+        ReadFuncCtx ctx{ func, userCtx };
+
+        auto chunk_func = [](const Entity* entities, const void* data, size_t count, void* userCtx) {
+            auto* rCtx = static_cast<ReadFuncCtx*>(userCtx);
+            rCtx->f(std::span<const Entity>(entities, count),
+                    std::span<const T>(static_cast<const T*>(data), count),
+                    rCtx->user);
+        };
+        ChunkTuner* tuner = chunkSize == AutoChunkSize
+            ? chunkTuner(TunedPass::Read, handle.id, [&] { return componentLabel(handle.id) + "/readParallelChunks"; })
+            : nullptr;
+        dispatchRead(handle.id, chunk_func, &ctx, chunkSize, tuner);
+    }
+
+    // --- Spatial Indexing ---
+
+    /**
+     * @brief Rebuilds `grid` from the current contents of a component. Points
+     * are read in parallel chunks, then bucket-sorted in one task per
+     * worker (serially for small grids).
+     */
+    template<typename T>
+    void rebuildSpatialIndex(ComponentHandle<T> handle, SpatialGrid<T>& grid, size_t chunkSize = 4096) {
+        const ComponentData* cd = componentDataById(handle.id);
+        if (!cd || cd->dense.empty()) {
+            grid.clear();
+            return;
+        }
+        grid.beginBuild(reinterpret_cast<const Entity*>(cd->dense.data()), cd->dense.size());
+        readParallelChunks<T>(handle, [](std::span<const Entity> entities, std::span<const T> components, void* g) {
+            static_cast<SpatialGrid<T>*>(g)->buildChunk(entities, components);
+        }, &grid, chunkSize);
+        const size_t workers = m_gw->workerCount ? m_gw->workerCount(m_gw->api) : std::thread::hardware_concurrency();
+        grid.endBuild(workers, [this](size_t tasks, auto&& body) {
+            WaitGroup group;
+            for (size_t t = 1; t < tasks; ++t) submit([&body, t] { body(t); }, &group);
+            body(0);
+            wait(group);
+        });
+    }
+
+    /**
+     * @brief Keeps `grid` in sync with a component through a system that
+     * rebuilds it once per frame, skipping frames in which nothing was
+     * attached, written or removed. Put the movement systems in
+     * `desc.runAfter` so queries see this frame's positions; the system
+     * declares a read of the component. `grid` must outlive the module API.
+     */
+    template<typename T>
+    void registerSpatialIndex(ComponentHandle<T> handle, SpatialGrid<T>& grid, SystemConfig desc = {}) {
+        struct SpatialIndexContext {
+            ModuleAPI* api;
+            ComponentHandle<T> handle;
+            SpatialGrid<T>* grid;
+            ChangeCursor cursor;
+        };
+        auto* moduleContext = m_contexts.make<SpatialIndexContext>(this, handle, &grid, ChangeCursor{});
+
+        auto core_trampoline = [](float, void* userData) {
+            auto* ctx = static_cast<SpatialIndexContext*>(userData);
+            bool changed = false;
+            ctx->api->template updateParallelChanged<T>(ctx->handle, ctx->cursor,
+                [](std::span<const Entity>, std::span<const T>, void* flag) {
+                    std::atomic_ref<bool>(*static_cast<bool*>(flag)).store(true, std::memory_order_relaxed);
+                }, &changed, 1u << 20);
+            // Removals move the last element into the hole, which counts as a
+            // write, but a removal from the tail only shows up in the size.
+            const ComponentData* cd = ctx->api->componentDataById(ctx->handle.id);
+            if (changed || !cd || cd->dense.size() != ctx->grid->size()) ctx->api->rebuildSpatialIndex(ctx->handle, *ctx->grid);
+        };
+
+        if (desc.systemName.empty()) desc.systemName = componentLabel(handle.id) + "_SpatialIndex";
+        desc.trigger = TriggerType::Always;
+        desc.reads = { handle.id };
+        desc.writes.clear();
+        registerSystem(desc, core_trampoline, moduleContext);
+    }
+
+    // --- Parallel Reduction ---
+
+    /**
+     * @brief Folds every T into an Acc without atomics on the values. Each
+     * chunk reduces into its own cache-line-padded partial, seeded with
+     * `init`; the partials are then put in range order and combined in a
+     * fixed tree. With a fixed chunkSize the result is the same whatever
+     * the thread count or scheduling
+     * (AutoChunkSize lets the chunk boundaries move between calls).
+     * `init` must be the identity of `combine`. The pass is read-only and
+     * does not mark anything as changed.
+     */
+    template<typename T, typename Acc>
+    Acc reduceParallel(ComponentHandle<T> handle, const Acc& init,
+                       void (*func)(std::span<const Entity>, std::span<const T>, Acc&, void*),
+                       void (*combine)(Acc&, const Acc&),
+                       void* userCtx = nullptr,
+                       size_t chunkSize = 1024) {
+        const ComponentData* cd = componentDataById(handle.id);
+        if (!cd || cd->dense.empty()) return init;
+
+        ChunkTuner* tuner = chunkSize == AutoChunkSize
+            ? chunkTuner(TunedPass::Reduce, handle.id, [&] { return componentLabel(handle.id) + "/reduceParallel"; })
+            : nullptr;
+        if (tuner) chunkSize = tuner->chunkSize();
+        // 0 (or anything past the range) is a single chunk.
+        chunkSize = std::clamp<size_t>(chunkSize ? chunkSize : cd->dense.size(), 1, cd->dense.size());
+        reduce_detail::Partials<Acc> partials((cd->dense.size() + chunkSize - 1) / chunkSize, init);
+
+        struct ReduceFuncCtx {
+            void (*f)(std::span<const Entity>, std::span<const T>, Acc&, void*);
+            void* user;
+            const Entity* first;
+            reduce_detail::Partials<Acc>* partials;
+        };
+        ReduceFuncCtx ctx{ func, userCtx, reinterpret_cast<const Entity*>(cd->dense.data()), &partials };
+
+        auto chunk_func = [](const Entity* entities, const void* data, size_t count, void* userCtx) {
+            auto* rCtx = static_cast<ReduceFuncCtx*>(userCtx);
+            Acc& acc = rCtx->partials->claim(static_cast<size_t>(entities - rCtx->first));
+            rCtx->f(std::span<const Entity>(entities, count),
+                    std::span<const T>(static_cast<const T*>(data), count),
+                    acc, rCtx->user);
+        };
+        dispatchRead(handle.id, chunk_func, &ctx, chunkSize, tuner);
+        return partials.finish(combine);
+    }
+
+    /**
+     * @brief Per-entity reduceParallel: func(Entity, const T&, Acc&).
+     */
+    template<typename T, typename Acc>
+    Acc reduceParallel(ComponentHandle<T> handle, const Acc& init,
+                       void (*func)(Entity, const T&, Acc&),
+                       void (*combine)(Acc&, const Acc&),
+                       size_t chunkSize = 1024) {
+        struct EntityFuncCtx {
+            void (*f)(Entity, const T&, Acc&);
+        };
+        EntityFuncCtx ctx{ func };
+
+        auto entity_func = [](std::span<const Entity> entities, std::span<const T> components, Acc& acc, void* userCtx) {
+            auto* eCtx = static_cast<EntityFuncCtx*>(userCtx);
+            for (size_t i = 0; i < entities.size(); ++i) eCtx->f(entities[i], components[i], acc);
+        };
+        return reduceParallel<T, Acc>(handle, init, +entity_func, combine, &ctx, chunkSize);
+    }
+
+    /**
+     * @brief reduceParallel over a group, one GroupView per chunk. The
+     * callback must not write through the view. Runs on the group pass, so
+     * unlike the component overloads it stamps the group range as changed.
+     */
+    template<typename Acc, typename... Ts>
+    Acc reduceParallel(GroupHandle<Ts...> group, const Acc& init,
+                       void (*func)(GroupView<Ts...>, Acc&, void*),
+                       void (*combine)(Acc&, const Acc&),
+                       void* userCtx = nullptr,
+                       size_t chunkSize = 1024) {
+        std::array<ComponentData*, sizeof...(Ts)> data{};
+        for (size_t i = 0; i < data.size(); ++i) data[i] = componentDataById(group.ids[i]);
+        GroupViewCtx<Ts...> view{ nullptr, nullptr, {}, nullptr };
+        if (!bindGroupColumns(view, data, group.ids)) return init;
+
+        ChunkTuner* tuner = nullptr;
+        if (chunkSize == AutoChunkSize) {
+            uint32_t key = 0;
+            for (uint32_t id : group.ids) key = key * 31u + id;
+            tuner = chunkTuner(TunedPass::Reduce, key, [&] { return groupLabel(group.ids) + "/reduceParallel"; });
+            chunkSize = tuner->chunkSize();
+        }
+        // The packed range is never longer than the smallest member, so
+        // that bounds the expected chunk count.
+        size_t bound = SIZE_MAX;
+        for (const ComponentData* cd : data) bound = std::min(bound, cd->dense.size());
+        if (bound == 0) return init;
+        chunkSize = std::clamp<size_t>(chunkSize ? chunkSize : bound, 1, bound);
+        reduce_detail::Partials<Acc> partials((bound + chunkSize - 1) / chunkSize, init);
+
+        struct ReduceGroupCtx {
+            void (*f)(GroupView<Ts...>, Acc&, void*);
+            void* user;
+            GroupViewCtx<Ts...> view;
+            reduce_detail::Partials<Acc>* partials;
+        };
+        ReduceGroupCtx ctx{ func, userCtx, view, &partials };
+
+        auto group_func = [](size_t start, size_t end, void* userCtx) {
+            auto* rCtx = static_cast<ReduceGroupCtx*>(userCtx);
+            rCtx->f(groupChunk(rCtx->view, start, end), rCtx->partials->claim(start), rCtx->user);
+        };
+        void (*pass)(size_t, size_t, void*) = group_func;
+        void* passCtx = &ctx;
+        chunking_detail::TimedChunks<size_t, size_t> timed{ group_func, &ctx, tuner };
+        if (tuner) {
+            pass = &decltype(timed)::invoke;
+            passCtx = &timed;
+        }
+        if (m_gw->updateParallelGroupById) {
+            m_gw->updateParallelGroupById(m_gw->api, group.ids.data(), group.ids.size(), pass, passCtx, chunkSize);
+        } else {
+            updateParallelGroup(groupNames(group), pass, passCtx, chunkSize);
+        }
+        if (tuner) tuner->endPass();
+        return partials.finish(combine);
     }
 
     // --- Messaging & Events ---
@@ -195,15 +2088,39 @@ public:
     void subscribe(const std::string& eventName, 
                    void (*handler)(const T&, void*), 
                    void* userData = nullptr) {
-        
+        subscribe(registerEvent<T>(eventName), handler, userData);
+    }
+    
+    /**
+     * @brief Registers an event type and returns its interned handle.
+     * Equal to makeEventHandle<T>(name); must be called once before the
+     * handle is used with subscribe/emitEvent/pushEvent.
+     */
+    template<typename T>
+    EventHandle<T> registerEvent(const std::string& eventName) {
+        getEventId(eventName);
+        return EventHandle<T>{ hashName(eventName) };
+    }
+
+    /**
+     * @brief Subscribes to a global event with type safety.
+     */
+    template<typename T>
+    void subscribe(EventHandle<T> handle,
+                   void (*handler)(const T&, void*),
+                   void* userData = nullptr) {
         if (!m_gw || !m_gw->subscribe) return;
-            
-        uint32_t eventID = getEventId(eventName);
-        auto* context = new EventContext<T>{ handler, userData, eventID }; 
-        
-        auto core_invoker = [](uint32_t id, const EventData& data, void* contextPtr) {
+
+        uint32_t eventID = resolveEventId(handle.id);
+        auto* context = m_contexts.make<EventContext<T>>(handler, userData, eventID);
+#if FRACTAL_PROFILING
+        context->profileName = Profiler::instance().intern("event#" + std::to_string(handle.id));
+#endif
+
+        auto core_invoker = [](uint32_t, const EventData& data, void* contextPtr) {
             auto* context = static_cast<EventContext<T>*>(contextPtr);
             if (context && context->originalHandler) {
+                FRACTAL_PROFILE_SCOPE(context->profileName, Event, 1);
                 const T& typedData = *static_cast<const T*>(data.ptr);
                 context->originalHandler(typedData, context->originalUserData);
             }
@@ -211,7 +2128,59 @@ public:
 
         m_gw->subscribe(m_gw->api, eventID, core_invoker, static_cast<void*>(context));
     }
-    
+
+    /**
+     * @brief Batch event ring for an event type, created on first use.
+     * Producers call reserve()/commit() or emplace() on the returned stream
+     * from any thread; a per-frame flush system drains it into the handlers
+     * registered with subscribeBatch. Look the stream up once and keep the
+     * reference: creating channels is not thread-safe.
+     */
+    template<typename T>
+    EventStream<T>& eventStream(EventHandle<T> handle, size_t capacity = 4096) {
+        return eventChannel(handle, capacity).stream;
+    }
+
+    /**
+     * @brief Subscribes a handler that receives all events queued since the
+     * last flush as spans (two spans when the ring wraps). Events emitted
+     * through the gateway by other modules are copied into the same ring;
+     * those that find it full follow in one more span.
+     */
+    template<typename T>
+    void subscribeBatch(EventHandle<T> handle,
+                        void (*handler)(std::span<const T>, void*),
+                        void* userData = nullptr) {
+        eventChannel(handle).handlers.push_back({ handler, userData });
+    }
+
+    /**
+     * @brief Number of gateway events that found the batch ring full and
+     * went through the overflow list instead. They are still delivered, but
+     * a growing count means the ring is too small for a frame's peak.
+     * Producers writing to eventStream() directly see emplace() fail instead.
+     */
+    template<typename T>
+    uint64_t eventOverflowCount(EventHandle<T> handle) const {
+        auto it = m_eventChannels.find(handle.id);
+        if (it == m_eventChannels.end()) return 0;
+        return static_cast<const EventChannel<T>&>(*it->second).overflowed.load(std::memory_order_relaxed);
+    }
+
+    template<typename T>
+    void emitEvent(EventHandle<T> handle, const T& data) {
+        if (m_gw && m_gw->emitEvent) {
+            m_gw->emitEvent(m_gw->api, resolveEventId(handle.id), (void*)&data, sizeof(T));
+        }
+    }
+
+    template<typename T>
+    void pushEvent(EventHandle<T> handle, const T& data) {
+        if (m_gw && m_gw->pushEvent) {
+            m_gw->pushEvent(m_gw->api, resolveEventId(handle.id), (void*)&data, sizeof(T));
+        }
+    }
+
     template<typename T>
     void emitEvent(const std::string& eventName, const T& data) {
         if (m_gw && m_gw->emitEvent) {
@@ -1,13 +1,45 @@
 #ifndef STRUCTUSES_AND_CLASSES_HEADER_
 #define STRUCTUSES_AND_CLASSES_HEADER_
 #include <stdint.h>
+#include <atomic>
 #include <functional>
 #include <chrono>
+#include <cstddef>
 #include <string>
 #include <cstring>
+#include <vector>
+#include <new>
+#include <type_traits>
+#include <utility>
+// Entity IDs pack a slot index (low 24 bits) and the slot's generation (high
+// 8 bits). Destroying an entity bumps its slot's generation, so a stale
+// handle to a recycled slot no longer matches. The generation wraps after
+// 256 reuses of a slot, after which a handle that old matches again; don't
+// keep handles across that many destroy/create cycles. Cores that never
+// recycle IDs simply leave the generation at 0.
 struct Entity
 {
     uint32_t id;
+
+    static constexpr uint32_t kIndexBits = 24;
+    static constexpr uint32_t kIndexMask = (1u << kIndexBits) - 1;
+    static constexpr uint32_t kMaxGeneration = (1u << (32 - kIndexBits)) - 1;
+
+    static constexpr Entity make(uint32_t index, uint32_t generation) {
+        return Entity{ (generation << kIndexBits) | (index & kIndexMask) };
+    }
+    constexpr uint32_t index() const { return id & kIndexMask; }
+    constexpr uint32_t generation() const { return id >> kIndexBits; }
+    constexpr bool operator==(const Entity&) const = default;
+};
+// Contiguous block of entity IDs [first.id, first.id + count).
+struct EntityRange
+{
+    Entity first{0};
+    size_t count = 0;
+
+    size_t size() const { return count; }
+    Entity operator[](size_t i) const { return Entity{ first.id + static_cast<uint32_t>(i) }; }
 };
 struct Task{
     std::function<void()> func;
@@ -24,6 +56,92 @@ struct TickTask{
     bool isBackTask=true;
 
 };
+// Move-only callable with inline storage: a fixed buffer plus two C
+// function pointers, so it crosses the module boundary without heap
+// allocation or std::function. Callables must fit in kCapacity bytes and be
+// nothrow-movable. Calling it does not consume it, so interval tasks run
+// the same object every time.
+class InlineTask {
+public:
+    static constexpr size_t kCapacity = 48;
+
+    InlineTask() = default;
+
+    template<typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InlineTask>>>
+    InlineTask(F&& f) {
+        using Fn = std::decay_t<F>;
+        static_assert(sizeof(Fn) <= kCapacity && alignof(Fn) <= alignof(std::max_align_t),
+                      "InlineTask: callable does not fit the inline buffer");
+        static_assert(std::is_nothrow_move_constructible_v<Fn>, "InlineTask: callable must be nothrow-movable");
+        static_assert(std::is_invocable_v<Fn&>, "InlineTask: callable must take no arguments");
+        ::new (static_cast<void*>(m_storage)) Fn(std::forward<F>(f));
+        m_invoke = [](void* storage) { (*static_cast<Fn*>(storage))(); };
+        // Trivial callables (plain captures of pointers and values) are moved with memcpy.
+        if constexpr (!std::is_trivially_copyable_v<Fn>) {
+            m_manage = [](void* dst, void* src) {
+                if (dst) ::new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+                static_cast<Fn*>(src)->~Fn();
+            };
+        }
+    }
+
+    // C-style callback: func(ctx).
+    InlineTask(void (*func)(void*), void* ctx)
+        : InlineTask([func, ctx] { func(ctx); }) {}
+
+    InlineTask(InlineTask&& other) noexcept { take(other); }
+    InlineTask& operator=(InlineTask&& other) noexcept {
+        if (this != &other) {
+            reset();
+            take(other);
+        }
+        return *this;
+    }
+    InlineTask(const InlineTask&) = delete;
+    InlineTask& operator=(const InlineTask&) = delete;
+    ~InlineTask() { reset(); }
+
+    explicit operator bool() const { return m_invoke != nullptr; }
+    void operator()() { m_invoke(m_storage); }
+
+    void reset() {
+        if (m_manage) m_manage(nullptr, m_storage);
+        m_invoke = nullptr;
+        m_manage = nullptr;
+    }
+
+private:
+    void take(InlineTask& other) {
+        if (other.m_manage) other.m_manage(m_storage, other.m_storage);
+        else if (other.m_invoke) std::memcpy(m_storage, other.m_storage, kCapacity);
+        m_invoke = std::exchange(other.m_invoke, nullptr);
+        m_manage = std::exchange(other.m_manage, nullptr);
+    }
+
+    alignas(std::max_align_t) unsigned char m_storage[kCapacity];
+    void (*m_invoke)(void*) = nullptr;
+    void (*m_manage)(void* dst, void* src) = nullptr;
+};
+// Counts submitted tasks that have not finished yet. A continuation armed
+// on the group is submitted once the count drops to zero, counted towards
+// continuationGroup. The top bit of `pending` marks an armed continuation,
+// so waiting on the group also covers its hand-off. Owned by the module;
+// must outlive its tasks.
+struct WaitGroup {
+    static constexpr size_t kArmed = size_t(1) << (sizeof(size_t) * 8 - 1);
+
+    std::atomic<size_t> pending{ 0 };
+    InlineTask continuation;
+    WaitGroup* continuationGroup = nullptr;
+};
+// Interval task on the core's timer wheel. Runs every intervalMs (at
+// frame granularity) until it has run `executions` times; 0 repeats until
+// cancelled. Background runs go to the pool and never overlap themselves.
+struct TickTaskDesc {
+    uint32_t intervalMs = 0;
+    uint32_t executions = 0;
+    bool isBackTask = true;
+};
 class Event {
     public:
     virtual ~Event() = default;
@@ -39,12 +157,34 @@ enum class SystemMode {
 enum class TriggerType {
     Always,
     TimeInterval,
-    TickInterval
+    TickInterval,
+    // Every frame, but only over components changed since the system's last
+    // run. Resolved by ModuleAPI; cores see it as Always.
+    OnChanged,
+    // Every frame for at most SystemConfig::budget seconds, resuming its walk
+    // over the component where the previous frame stopped. Resolved by
+    // ModuleAPI; cores see it as Always.
+    Budgeted
 };
 struct EventData {
     void* ptr;
     size_t size;
 };
+// Describes one field of a component registered in structure-of-arrays
+// mode: its byte offset and size inside the original struct.
+struct FieldDesc {
+    size_t offset;
+    size_t size;
+};
+// What a module expects a snapshotted component to look like. Restores
+// are refused unless both fields match what the snapshot recorded.
+struct SnapshotLayout {
+    uint32_t id;
+    uint64_t elementSize;
+    uint64_t layoutHash;
+};
+// Modules only read data, elementSize and dense. sparse belongs to the
+// core, which may keep its entity-to-dense lookup elsewhere and leave it empty.
 struct ComponentData {
 
     void* data = nullptr;
@@ -76,6 +216,42 @@ struct SystemDesc {
     size_t tickAcc = 0;
 };
 
+// What a system touches and how it is ordered, passed to the core through
+// registerSystemAccess next to its SystemDesc. Component IDs are hashName
+// of the component name; ordering refers to other systems by name. Plain
+// arrays keep the layout independent of the module's standard library; the
+// core copies them during the call.
+struct SystemAccess {
+    const uint32_t* reads;
+    size_t readCount;
+    const uint32_t* writes;
+    size_t writeCount;
+    const char* const* runBefore;
+    size_t runBeforeCount;
+    const char* const* runAfter;
+    size_t runAfterCount;
+};
+
+// Module-side system description taken by ModuleAPI. Only the SystemDesc
+// part reaches the core as a struct; ModuleAPI forwards the rest as a
+// SystemAccess or handles it itself.
+struct SystemConfig : SystemDesc {
+    SystemConfig() = default;
+    SystemConfig(const SystemDesc& desc) : SystemDesc(desc) {}
+
+    // Components the system's callback reads and writes, including any it
+    // reaches through getComponent. Systems whose sets don't conflict may
+    // run concurrently; a system that declares neither is treated as
+    // touching everything.
+    std::vector<uint32_t> reads;
+    std::vector<uint32_t> writes;
+    // Explicit ordering against other systems, by system name.
+    std::vector<std::string> runBefore;
+    std::vector<std::string> runAfter;
+    // Per-frame time budget in seconds for TriggerType::Budgeted.
+    float budget = 0.0f;
+};
+
 
 class Clock;
 #pragma once
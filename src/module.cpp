@@ -1,8 +1,14 @@
 #include "headers/FractalCORE_gateway.h"
 #include "headers/FractalCORE_wrapper.h"
+#include "headers/FractalCORE_handles.h"
 #include "headers/Structs&Classes.h"
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <span>
 #include <string>
+#include <vector>
 
 // --- 1. Module-specific structures ---
 
@@ -19,24 +25,33 @@ struct PlayerMoveEvent {
     float newY;
 };
 
+// Interned handles, resolved at compile time so hot paths never touch strings
+constexpr auto PositionHandle = makeComponentHandle<PositionComponent>("Position");
+constexpr auto PlayerMoveHandle = makeEventHandle<PlayerMoveEvent>("PlayerMove");
+
 // --- 2. System logic ---
 
-// Update function for movement system (high-level C++ logic)
-void MovementSystemUpdate(Entity e, PositionComponent& pos, float dt) {
+// Update function for movement system (high-level C++ logic).
+// Receives a whole packed chunk, so the loop below is free to vectorize.
+void MovementSystemUpdate(std::span<const Entity>, std::span<PositionComponent> positions, float dt) {
     // Simple movement: advance X based on dt
-    pos.x += dt * 10.0f;
+    const float step = dt * 10.0f;
+    for (PositionComponent& pos : positions) {
+        pos.x += step;
+    }
 }
 
-// Event handler for PlayerMoveEvent
-void OnPlayerMove(const PlayerMoveEvent& eventData, void* userData) {
+// Batch event handler for PlayerMoveEvent: receives every move queued this frame
+void OnPlayerMove(std::span<const PlayerMoveEvent> events, void* userData) {
     ModuleAPI* api = static_cast<ModuleAPI*>(userData);
 
-
     // Update the Position component via the module API if present
-    PositionComponent* pos = api->getComponent<PositionComponent>(eventData.entity, "Position");
-    if (pos) {
-        pos->x = eventData.newX;
-        pos->y = eventData.newY;
+    for (const PlayerMoveEvent& eventData : events) {
+        PositionComponent* pos = api->getComponent(eventData.entity, PositionHandle);
+        if (pos) {
+            pos->x = eventData.newX;
+            pos->y = eventData.newY;
+        }
     }
 }
 
@@ -51,17 +66,25 @@ void ImmediateMove(Entity e, PositionComponent& pos) {
 
 // --- 3. Module entry points ---
 
+// Neighbour lookups over Position, rebuilt each frame after movement
+static SpatialGrid<PositionComponent> g_positionGrid(16.0f);
+
+// Owns every context the module registered with the core; reset in onUnload.
+static std::unique_ptr<ModuleAPI> g_moduleApi;
+
 extern "C" {
     // Called by the core when the module is loaded
     void onLoad(FractalCORE_Gateway* gateway) {
-        // Use a local static ModuleAPI to ensure it lives until module unload
-        static ModuleAPI moduleApi(gateway);
+        // Lives until onUnload, which releases all of its registration contexts at once
+        g_moduleApi = std::make_unique<ModuleAPI>(gateway);
+        ModuleAPI& moduleApi = *g_moduleApi;
 
         std::cout << "--- My Module Initialized ---" << std::endl;
 
         try {
             // Register component type
             moduleApi.registerComponent<PositionComponent>("Position");
+            moduleApi.registerEvent<PlayerMoveEvent>("PlayerMove");
             std::cout << "Registered Component: Position" << std::endl;
 
             // Register an always-running system that iterates over "Position"
@@ -74,37 +97,63 @@ extern "C" {
             );
             std::cout << "Registered System: Position_UpdateSystem (Always)" << std::endl;
 
+            // Keep the spatial index current once movement has run
+            SystemConfig gridDesc;
+            gridDesc.systemName = "Position_SpatialIndex";
+            gridDesc.runAfter = { "Position_UpdateSystem" };
+            moduleApi.registerSpatialIndex(PositionHandle, g_positionGrid, gridDesc);
+            std::cout << "Registered System: Position_SpatialIndex" << std::endl;
+
             // Subscribe to PlayerMove events
-            moduleApi.subscribe<PlayerMoveEvent>(
-                "PlayerMove",
+            moduleApi.subscribeBatch(
+                PlayerMoveHandle,
                 OnPlayerMove,
                 &moduleApi
             );
             std::cout << "Subscribed to Event: PlayerMove" << std::endl;
 
-            // Create 10k entities with a Position component
-            const size_t COUNT = 10000;
-            std::cout << "Creating " << COUNT << " entities..." << std::endl;
-            for (size_t i = 0; i < COUNT; ++i) {
-                Entity e = moduleApi.createEntity();
-                PositionComponent pc;
-                pc.x = static_cast<float>(i);
-                pc.y = 0.0f;
-                moduleApi.attachComponent<PositionComponent>(e, "Position", pc);
-                if (((i + 1) % 1000) == 0) {
-                    std::cout << "Created " << (i + 1) << " entities." << std::endl;
+            // Warm start: FRACTAL_SNAPSHOT names a snapshot saved by a previous onUnload
+            const char* snapshotPath = std::getenv("FRACTAL_SNAPSHOT");
+            if (snapshotPath && moduleApi.loadSnapshot(snapshotPath)) {
+                std::cout << "Restored entities from snapshot " << snapshotPath << std::endl;
+            } else {
+                // Create 10k entities with a Position component in one batch
+                const size_t COUNT = 10000;
+                std::cout << "Creating " << COUNT << " entities..." << std::endl;
+                EntityRange entities = moduleApi.createEntities(COUNT);
+                std::vector<PositionComponent> positions(COUNT);
+                for (size_t i = 0; i < COUNT; ++i) {
+                    positions[i].x = static_cast<float>(i);
+                    positions[i].y = 0.0f;
                 }
+                moduleApi.attachComponents<PositionComponent>(entities, PositionHandle, positions);
+                std::cout << "Created " << entities.size() << " entities." << std::endl;
             }
 
             std::cout << "All entities created. Running 5 immediate parallel update passes..." << std::endl;
             // Run a few immediate parallel update passes to advance positions.
             for (int pass = 0; pass < 5; ++pass) {
-                moduleApi.updateParallel<PositionComponent>("Position", ImmediateMove, 256);
+                moduleApi.updateParallel<&ImmediateMove>(PositionHandle, AutoChunkSize);
                 std::cout << "Completed update pass " << (pass + 1) << "/5" << std::endl;
             }
 
             std::cout << "Mass creation and updates finished." << std::endl;
 
+            // Range query against the index instead of a scan of every Position
+            moduleApi.rebuildSpatialIndex(PositionHandle, g_positionGrid);
+            std::vector<Entity> nearby;
+            g_positionGrid.queryRadius(RadiusQuery{ 100.0f, 2.5f, 10.0f }, nearby);
+            std::cout << "Entities within 10 of (100, 2.5): " << nearby.size() << std::endl;
+
+#if FRACTAL_PROFILING
+            // Dump what the profiler saw during startup
+            Profiler::instance().collect();
+            for (const Profiler::Stats& stats : Profiler::instance().summary()) {
+                std::cout << "Profile " << Profiler::categoryName(stats.category) << " " << stats.name
+                          << ": avg " << stats.avgMs << " ms, max " << stats.maxMs << " ms, n=" << stats.count << std::endl;
+            }
+#endif
+
         } catch (const std::exception& e) {
             std::cerr << "Module Initialization Error: " << e.what() << std::endl;
         }
@@ -113,6 +162,25 @@ extern "C" {
     // Called by the core when the module is unloaded (optional)
     void onUnload() {
         std::cout << "--- My Module Unloaded ---" << std::endl;
-        // Free any dynamic resources here if needed (EventContexts, SystemModuleContexts)
+#if FRACTAL_PROFILING
+        Profiler::instance().collect();
+        std::ofstream trace("ExampleModule_trace.json");
+        Profiler::instance().writeChromeTrace(trace);
+#endif
+        if (g_moduleApi) {
+            // By now the systems have run, so the tuners have settled
+            for (const ChunkTuner::Report& r : g_moduleApi->chunkSizeReport()) {
+                std::cout << "Tuned chunk size " << r.label << ": " << r.chunkSize
+                          << " (" << r.nsPerElement << " ns/entity)" << std::endl;
+            }
+            if (uint64_t overflowed = g_moduleApi->eventOverflowCount(PlayerMoveHandle)) {
+                std::cout << "PlayerMove events past the batch ring: " << overflowed << std::endl;
+            }
+        }
+        if (const char* snapshotPath = std::getenv("FRACTAL_SNAPSHOT"); snapshotPath && g_moduleApi) {
+            if (!g_moduleApi->saveSnapshot(snapshotPath)) std::cerr << "Snapshot save failed: " << snapshotPath << std::endl;
+        }
+        // Frees the system/event contexts registered in onLoad
+        g_moduleApi.reset();
     }
 }
\ No newline at end of file